@@ -11,12 +11,16 @@ can force a sub-optimal position.*/
 #include <fstream>
 #include <cstdlib>
 #include <string>
+#include <cstring>
 #include <cctype>
 #include <cmath>
 #include <ctime>
 #include <chrono>
-#include <unordered_map>
 #include "board.h"
+#include "tablebase.h"
+#include "book.h"
+#include "eval.h"
+#include "engine.h"
 #include "AI.h"
 
 using namespace std;
@@ -24,20 +28,10 @@ using namespace std;
 //constructor
 //parameters: NA
 //returns: NA
-AI::AI() {
-    state = new Board;
-
+AI::AI() : Engine(new Thomas_eval) {
     name = "Thomas";
 
-    srand(time(NULL));
-    
-    //default, impossible values for AI's chosen move
-    row1 = 8;
-    col1 = 'I';
-    row2 = 8;
-    col2 = 'I';
-
-    diverge = false, repeat = false, clear = false;
+    rng.seed(time(NULL)); //varied play by default, set_seed makes it repeatable
 
     int cutoff_start = -10000;
     for (int i = 0; i < 100; i++) {
@@ -45,27 +39,34 @@ AI::AI() {
         cutoff_start = -cutoff_start;
     }
 
-    for (int i = 0; i < 100; i++) {
-        for (int j = 0; j < 64; j++) {
-            for (int k = 0; k < 64; k++) {
-                history[i][j][k] = 0;
-            }
-        }
-    }
-
     difficulty = 3;
     time_limit = 60;
 
-    memory->reserve(1000000); //reserve starting table space to reduce reallocation time
+    node_limit = 0, movetime = 0, deadline = 0;
+    nodes = 0, stopped = false, ran_out = false;
+    completed = 0, best_score = 0;
+    ply = 0, follow_pv = false, scout = false;
+    best_line.length = 0, seed.length = 0;
+    multi_pv = 1, ranked = 0;
+
+    memory = new Table<Mem_node>(HASH_MB);
+
+    book = new Book("book.bin");
+    book_on = true;
+
+    ponder_on = false, pondering = false, ponder_hit = false;
+    saved_limit = time_limit;
 }
 
 //destructor
 //parameters: NA
 //returns: NA
 AI::~AI() {
-    delete state;
-    memory->clear();
+    if (pondering)
+        stop_pondering();
+
     delete memory;
+    delete book;
 }
 
 //intro, prints an intro message
@@ -95,69 +96,207 @@ void AI::set_difficulty(int level) {
     }
 }
 
+//set_limits, sets the search directly for analysis, rather than by difficulty level. Without a depth,
+//iterative deepening goes on until another limit is reached or the search is stopped. Clears an 
+//earlier stop, so it has to be called before the search is started on its thread, not from it.
+//parameters: ints for the depth, the time in milliseconds and the number of positions to search, 0 
+//for no limit
+//returns: void
+void AI::set_limits(int depth, long long time, long long positions) {
+    difficulty = ((depth > 0) && (depth <= MAX_DEPTH)) ? depth : MAX_DEPTH;
+    time_limit = 1LL << 40; //only the limits below apply
+    movetime = time, node_limit = positions;
+    stopped = false;
+}
+
+//set_multi_pv, sets the number of root moves the search finds exact scores and lines for, rather than
+//only the best, for analysis, at the cost of cutting off fewer moves at the root
+//parameters: an int for the number of lines, from 1 to MULTI_PV_MAX
+//returns: void
+void AI::set_multi_pv(int lines) {
+    multi_pv = (lines < 1) ? 1 : ((lines > MULTI_PV_MAX) ? MULTI_PV_MAX : lines);
+}
+
+//set_reporter, sets a function to call with the depth, score, positions searched and principal 
+//variation each time the search completes a depth
+//parameters: the function, which is called from the searching thread
+//returns: void
+void AI::set_reporter(function<void(const Search_info&)> report) {
+    reporter = report;
+}
+
+//stop, ends the current search, which keeps the move from the deepest search it completed
+//parameters: NA
+//returns: void
+void AI::stop() {
+    stopped = true;
+}
+
+//use_book, turns the opening book on or off, so that a book can be built from searches alone
+//parameters: a bool for whether to use the book
+//returns: void
+void AI::use_book(bool on) {
+    book_on = on;
+}
+
+//set_hash, replaces the transposition table with an empty one of a given size
+//parameters: an int for the size in megabytes, rounded down to a power of 2 slots
+//returns: void
+void AI::set_hash(int mb) {
+    memory->resize(mb);
+}
+
+//clear_hash, empties the transposition table
+//parameters: NA
+//returns: void
+void AI::clear_hash() {
+    memory->clear();
+}
+
+//use_ponder, turns pondering on or off, off by default, since it needs a driver that calls ponder
+//after each of the AI's turns and update_AI once the opponent has moved
+//parameters: a bool for whether to ponder
+//returns: void
+void AI::use_ponder(bool on) {
+    ponder_on = on;
+}
+
+//ponder, guesses the opponent's reply from the transposition table and starts searching the position 
+//after it on another thread, without a time limit, so the table fills while the opponent thinks. 
+//update_AI checks the guess: on a hit the search goes on with the level's time counted from then, 
+//and move waits for it, and on a miss it's stopped and its move thrown away.
+//parameters: NA
+//returns: void
+void AI::ponder() {
+    if ((!ponder_on) || (pondering))
+        return;
+
+    Board reply(*state);
+    const Book_entry *first;
+    if ((!expect_reply(reply)) || ((book_on) && (book->find(reply.get_hash('B'), first) > 0)))
+        return; //nothing to search, or a book move will be played
+
+    played.push_back(state->get_hash('W'));
+    played.push_back(reply.get_hash('B'));
+    expected = reply;
+    delete state;
+    state = new Board(reply);
+
+    saved_limit = time_limit;
+    time_limit = 1LL << 40;
+    stopped = false;
+    pondering = true, ponder_hit = false;
+    ponderer = thread(&AI::search, this, true);
+}
+
 //update_AI, updates the board held by the AI to the game board
 //parameters: a Board to put in the copy constructor
 //returns: void
 void AI::update_AI(const Board ref) {
-    int pieces = state->get_num_black() + state->get_num_white();
-    
+    if (pondering) {
+        if (expected.same(ref)) {
+            //ponder hit, the search carries on with the time it would have had from now
+            if (!ponder_hit) {
+                start_time = time(NULL);
+                time_limit = saved_limit;
+                ponder_hit = true;
+            }
+            return;
+        }
+
+        stop_pondering();
+    }
+
     delete state;
     state = new Board(ref); //copy over board data
-    
-    if (state->get_num_black() + state->get_num_white() < pieces)
-        clear = true;
 }
 
-//move, AI makes its decision about where to move
-//parameters: a bool for whether or not to choose a somewhat sub-optimal move, to break repetitions
+//set_history, sets the hashes of the game's positions since the last take or man move, so the search
+//can score a return to one of them as a draw
+//parameters: a ref to the hashes, ending with the position to move from
 //returns: void
-void AI::move(bool sub, bool go) {
+void AI::set_history(const vector<uint64_t> &keys) {
+    if (pondering)
+        return; //the ponder search already has them, and is reading them
+
+    played = keys;
+}
+
+//move, AI makes its decision about where to move, taking the ponder search's move on a ponder hit,
+//or a book move, before searching
+//parameters: a bool for whether to make the move on the AI's board
+//returns: void
+void AI::move(bool go) {
+    if ((go) && (ponder_hit)) {
+        //the search started while pondering is the one for this move
+        ponderer.join();
+        pondering = false, ponder_hit = false;
+        state->make_move(col1, row1, col2, row2);
+        return;
+    }
+
+    if ((go) && (!pondering) && (from_book()))
+        return; //known opening, no search needed
+
+    search(go);
+}
+
+//search, searches the held position for the move to make. Run on the ponder thread directly, so it
+//never waits on itself, and by iterative deepening for the shallower searches before the last.
+//parameters: a bool for whether to make the move on the AI's board, false for a shallower search
+//run by iterative deepening
+//returns: void
+void AI::search(bool go) {
     int count = 0, make; //number of possible moves, number iterated through so far
     char c1 = 'A', c2 = 'A', taken = 'X'; //position variables
     int r1 = 0, r2 = 0;
-    int *moves_r = new int[180]; //arrays with square locations for possible moves
-    char *moves_c = new char[180];
     bool restore = false;
 
-    pre_move(sub, go);
+    pre_move(go);
+    int *moves_r = arena->make<int>(180); //arrays with square locations for possible moves
+    char *moves_c = arena->make<char>(180);
     
     //ensure that at least some calculation takes place in timed mode
     while ((difficulty < 8) && (time(NULL) - start_time >= time_limit)) {
         start_time++;
     }
 
-    iterative_deepening(sub);
+    iterative_deepening();
 
-    Node *start = new Node; //make root Node, with given position as board
+    Node *start = arena->make<Node>(1); //make root Node, with given position as board
     start->position = state;
-    fill_b(start, moves_c, moves_r, count, NA, restore); //fill move arrays with possible moves
-    start->options = new Node[count]; //create subtrees for each possible move
+    line[0] = state->get_hash('B');
+    fill<'B'>(start, moves_c, moves_r, count, NA, restore, -10000, 10000); //fill move arrays with possible moves
+    ply = 0, follow_pv = true, jumping[0] = false;
+    pv_first(moves_c, moves_r, count); //the best move from the last search goes first
+    start->options = arena->make<Node>(count); //create subtrees for each possible move
 
     cutoffs[1] = -10000; //reset alpha
+    int top[MULTI_PV_MAX], kept = 0; //best scores so far, for a multi-PV search
     
     for (make = 0; make < count; make++) {
-        moving_b(start, moves_c, moves_r, make, c1, c2, r1, r2, true, taken); //fill child node
-        evaluate_move_b(start, c1, r1, c2, r2, make, 0);
-        if (start->options[make].score > cutoffs[1])
+        moving<'B'>(start, moves_c, moves_r, make, c1, c2, r1, r2, true, taken); //fill child node
+        evaluate_move<'B'>(start, c1, r1, c2, r2, make, 0);
+        root_lines[make] = pv_lines[1], root_scores[make] = start->options[make].score;
+        if (multi_pv > 1) {
+            cutoffs[1] = root_window(top, kept, start->options[make].score);
+        } else if (start->options[make].score > cutoffs[1]) {
             cutoffs[1] = start->options[make].score; //set alpha
+        }
 
-        if ((closeness(*start->options[make].position, 'W') < closeness(*start->position, 'W')) && 
+        if ((eval->closeness(*start->options[make].position, 'W') < eval->closeness(*start->position, 'W')) && 
         (start->position->get_num_black() >= start->position->get_num_white()) && 
         (start->position->get_num_white() < 5))
-            start->options[make].score += rand () % 6; //weight aggressive king moves 
-
-        delete start->options[make].position;
+            start->options[make].score += rng() % 6; //weight aggressive king moves 
     }
     
-    choose_move(start, count, make, sub);
-    
-    if (go)
-        state->make_move(col1, row1, col2, row2), repeat = false;
+    choose_move(start, count);
+
+    if ((completed == difficulty) && (reporter))
+        reporter(get_info());
     
-    delete [] moves_r;
-    delete [] moves_c;
-    delete [] start->options;
-    delete start;
+    if ((go) && (!pondering))
+        state->make_move(col1, row1, col2, row2);
 }
 
 //multi, similar to move, but used when a piece has taken and my do so again. Evaluates best 
@@ -168,15 +307,15 @@ bool AI::multi(bool go) {
     char c1 = col2, c2 = 'A', taken = 'X'; //position variables
     int r1 = row2, r2 = 0;
     int count = 0, make; //number of possible moves, number iterated through so far
-    int *moves_r = new int[8]; //arrays with square locations for possible moves
-    char *moves_c = new char[8];
 
     //ensure that at least some calculation takes place in timed mode
     while ((difficulty < 8) && (time(NULL) - start_time >= time_limit)) {
         start_time++;
     }
 
-    pre_move(false, go);
+    pre_move(go);
+    int *moves_r = arena->make<int>(8); //arrays with square locations for possible moves
+    char *moves_c = arena->make<char>(8);
 
     if (difficulty > 3) {
         difficulty--;
@@ -184,457 +323,76 @@ bool AI::multi(bool go) {
         difficulty++;
     }
     
-    Node *start = new Node; //make root Node, with given position as board value
+    Node *start = arena->make<Node>(1); //make root Node, with given position as board value
     start->position = state;
+    line[0] = state->get_hash('B');
 
     cutoffs[1] = -10000;
+    int top[MULTI_PV_MAX], kept = 0; //best scores so far, for a multi-PV search
 
     fill_multi(moves_c, moves_r, count, c1, r1, 'B'); //find possible moves from single square
+    ply = 0, follow_pv = true, jumping[0] = true; //the turn's first jump has been made
+    pv_first(moves_c, moves_r, count);
 
-    start->options = new Node[count];
+    start->options = arena->make<Node>(count);
 
     for (make = 0; make < count; make++) {
-        moving_b(start, moves_c, moves_r, make, c1, c2, r1, r2, true, taken); //fill child node
+        moving<'B'>(start, moves_c, moves_r, make, c1, c2, r1, r2, true, taken); //fill child node
 
-        evaluate_move_b(start, c1, r1, c2, r2, make, 0);
+        evaluate_move<'B'>(start, c1, r1, c2, r2, make, 0);
+        root_lines[make] = pv_lines[1], root_scores[make] = start->options[make].score;
 
-        if (start->options[make].score > cutoffs[1])
+        if (multi_pv > 1) {
+            cutoffs[1] = root_window(top, kept, start->options[make].score);
+        } else if (start->options[make].score > cutoffs[1]) {
             cutoffs[1] = start->options[make].score; //set alpha-beta value
-
-        delete start->options[make].position;
+        }
     }
 
-    choose_move(start, count, make, false);
+    choose_move(start, count);
 
     if (go)
         state->make_move(col1, row1, col2, row2);
 
-    delete [] moves_c;
-    delete [] moves_r;
-    delete [] start->options;
-    delete start;
-
     return ((state->jump_possible(col2, row2, 'B')) && (!state->kinged()));
 }
 
-//functions to get notation of decided move
-
-//get_row1, get row of first square of decided move
-//parameters: NA
-//returns: a char for the row
-char AI::get_row1() {
-    return row1;
-}
-
-//get_col1, get col of first square of decided move
-//parameters: NA
-//returns: an int for the col
-int AI::get_col1() {
-    return col1;
-}
-
-//get_row2, get row of second square of decided move
-//parameters: NA
-//returns: a char for the row
-char AI::get_row2() {
-    return row2;
-}
-
-//get_col2, get col of first square of decided move
-//parameters: NA
-//returns: an int for the col
-int AI::get_col2() {
-    return col2;
-}
-
-//calc, evaluates the positional score of a leaf Node position
-//parameters: a ref to a Board object
-//returns: and integer for the position's score
-int AI::calc(Board &ref) {
-    //piece scores
-    int black = 0, white = 0;
-    char num_b = ref.get_num_black(), num_w = ref.get_num_white(), R, C;
-
-    //(incomplete) check for win or loss based on number of pieces
-    if (num_w == 0) {
-        return 9900;
-    } else if (num_b == 0) {
-        return -9900;
-    }
-
-    //iterate through the white pieces, giving each a value based on its type and locations
-    for (int i = 0; i < num_w; i++) {
-        R = ref.get_place_row_w(i);
-        C = ref.get_place_col_w(i);
-
-        //kings are worth about 1.5 times as much as regular pieces, and more if close to oppossing 
-        //pieces if the player is ahead in pieces
-        //iterate through white pieces
-        if (ref.get_place_king_w(i)) {
-            if (num_w > num_b) {
-                white += 336 - (3 * proximity(R, C, 'W', ref, num_b, num_w));
-            } else {
-                white += 336 - (1 * proximity(R, C, 'W', ref, num_b, num_w));
-            }
-
-            if (((R == 2) && (ref.look(R - 2, C) == BLACK_KING)) || ((R == 5) && 
-            (ref.look(R + 2, C) == BLACK_KING)) || ((C == 2) && (ref.look(R, C - 2) == BLACK_KING)) ||
-            ((C == 5) && (ref.look(R, C + 2) == BLACK_KING))) {
-                white += 20;
-            }
-            
-        } else {
-            white += 214 - 2 * R;
-
-            if ((C == 0) || (C == DIMEN_LESS1))
-                white += 4;
-
-            if (((R < DIMEN_LESS1) && (C > 0) && (ref.look(R + 1, C - 1) == WHITE_PIECE)) || 
-            ((R < DIMEN_LESS1) && (C < DIMEN_LESS1) && ref.look(R + 1, C + 1) == WHITE_PIECE))
-                white += 4;
-        }
-    }
-
-    //iterate through black pieces
-    for (int i = 0; i < num_b; i++) {
-        R = ref.get_place_row_b(i);
-        C = ref.get_place_col_b(i);
-
-        if (ref.get_place_king_b(i)) {
-            if (num_b > num_w) {
-                black += 336 - (3 * proximity(R, C, 'B', ref, num_b, num_w));
-            } else {
-                black += 336 - (1 * proximity(R, C, 'B', ref, num_b, num_w));
-            }
-
-            if (((R == 2) && (ref.look(R - 2, C) == WHITE_KING)) || ((R == 5) && 
-            (ref.look(R + 2, C) == WHITE_KING)) || ((C == 2) && (ref.look(R, C - 2) == WHITE_KING)) ||
-            ((C == 5) && (ref.look(R, C + 2) == WHITE_KING))) {
-                black += 20;
-            }
-
-        } else {
-            black += 193 + 2 * R;
-
-            if ((C == 0) || (C == DIMEN_LESS1))
-                black += 4;
-
-            if (((R > 0) && (C < DIMEN_LESS1) && (ref.look(R - 1, C + 1) == BLACK_PIECE)) || 
-            ((R > 0) && (C > 0) && ref.look(R - 1, C - 1) == BLACK_PIECE))
-                black += 4;
-        }
-    }
-
-    //if there is a single piece of a color, assign value to its being in a double corner or close to center
-    if ((num_b == 1) && (num_w > 1)) {
-        if ((ref.look(6, 7) == BLACK_KING) || (ref.look(7, 6) == BLACK_KING) || 
-        (ref.look(0, 1) == BLACK_KING) || (ref.look(1, 0) == BLACK_KING) ||
-        (ref.look(6, 5) == BLACK_KING) || (ref.look(5, 6) == BLACK_KING) ||
-        (ref.look(1, 2) == BLACK_KING) || (ref.look(2, 1) == BLACK_KING))
-            black += 50;
-    } else if ((num_w == 1) && (num_b > 1)) {
-        if ((ref.look(6, 7) == WHITE_KING) || (ref.look(7, 6) == WHITE_KING) || 
-        (ref.look(0, 1) == WHITE_KING) || (ref.look(1, 0) == WHITE_KING) || 
-        (ref.look(6, 5) == WHITE_KING) || (ref.look(5, 6) == WHITE_KING) ||
-        (ref.look(1, 2) == WHITE_KING) || (ref.look(2, 1) == WHITE_KING))
-            white += 50;
-    }
-
-    //value trapping an opposing king in a single square corner
-    if ((ref.look(0, 7) == WHITE_KING) && (ref.look(2, 5) == BLACK_KING)) {
-        black += 25;
-    } else if ((ref.look(0, 7) == BLACK_KING) && (ref.look(2, 5) == WHITE_KING)) {
-        white += 25;
-    }
-
-    if ((ref.look(7, 0) == WHITE_KING) && (ref.look(5, 2) == BLACK_KING)) {
-        black += 25;
-    } else if ((ref.look(7, 0) == BLACK_KING) && (ref.look(5, 2) == WHITE_KING)) {
-        white += 25;
-    }
-
-    //value of having more pieces increases exponentially with declining number of pieces
-    if (num_w > num_b) {
-        int temp = (num_w - num_b) * (17 - num_b) * (17 - num_b);
-
-        if (temp < 5000) {
-            white += temp;
-        } else {
-            white += 5000; //avoid value here higher than winning value
-        }
-    } else if (num_b > num_w) {
-        int temp = (num_b - num_w) * (17 - num_w) * (17 - num_w);
-
-        if (temp < 5000) {
-            black += temp;
-        } else {
-            black += 5000; //avoid value here higher than winning value
-        }
-    }
-    
-    return (black - white);
-}
-
-//proximity, finds how close a piece is to the nearest opposing king
-//parameters: an int for the piece's row, an int for its column, a string for the color of the piece, a ref 
-//to a Board object to scan, ints for the numbers of black and white pieces
-//returns: an int for the distance to the nearest opposing king
-int AI::proximity(int row, int column, char turn, Board &ref, int num_b, int num_w) {
-    int dist = 5, x = 0, y = 0;
-
-    if (turn == 'W') {
-        for (int i = 0; i < num_b; i++) {
-        if (ref.get_place_king_b(i)) {
-                x = abs(ref.get_place_col_b(i) - column);
-                y = abs(ref.get_place_row_b(i) - row);
-    
-                if ((x < dist) && (y < dist)) {
-                    if (x > y) {
-                        dist = x;
-                    } else {
-                        dist = y;
-                    }
-                }  
-            }
-        }
-    } else {
-        for (int i = 0; i < num_w; i++) {
-            if (ref.get_place_king_w(i)) {
-                x = abs(ref.get_place_col_w(i) - column);
-                y = abs(ref.get_place_row_w(i) - row);
-
-                if ((x < dist) && (y < dist)) {
-                    if (x > y) {
-                        dist = x;
-                    } else {
-                        dist = y;
-                    }
-                }
-            }
-        }
-    }
-
-    return dist; //dist is smaller of column difference and row difference
-}
-
-//fill_b, fills move arrays with coordinates, testing all possible movements for each piece in the Board 
-//object's black piece position arrays
+//fill, fills move arrays with the moves for the color to move, given as the template parameter, only 
+//the jumps from the piece that made the last one if a jump goes on with more than one way to go, with
+//the best move stored in the transposition table first, if the position is stored, and the rest 
+//ordered by killer and history
 //parameters: pointer to a Node, a char array of column coordinates, an int array of row coordinates, 
-//and a pointer to the count integer
-//returns: void
-int AI::fill_b(Node *start, char moves_c[], int moves_r[], int &count, int depth, bool &restore) {
-    string *look = make_key(*start->position, 'B');
-    unordered_map<string, Mem_node>::iterator place = memory->find(*look);
-    if (place != memory->end()) {
-        count = place->second.children;
-        if ((((state->get_num_white() > 3) && (place->second.depth >= depth)) || 
-        (place->second.depth == depth)) && (depth != NA)) {
-            delete [] moves_c;
-            delete [] moves_r;
-            return place->second.score;
-        } else {
-            for (int i = 0; i < 2 * place->second.children; i++) {
-                moves_c[i] = place->second.child_c[i];
-                moves_r[i] = place->second.child_r[i];
-            }
-            count = place->second.children;
-        }
-    } else {
-        char c1;
-        int r1;
-        bool forced = start->position->forced_take('B'); //check for forced jump
-        if ((!forced) && (!start->position->any_move('W')) && (depth != NA)) {
-            delete [] moves_c;
-            delete [] moves_r;
-            return -9950 - depth; //check for loss, value modified by depth
-        }
-        for (int i = 0; i < start->position->get_num_black(); i++) {
-            //iterate through each black piece
-            c1 = start->position->get_place_col_b(i) + 'A';
-            r1 = start->position->get_place_row_b(i);
-            if (!forced) {
-                if ((r1 < DIMEN_LESS1) && (c1 - 'A' < DIMEN_LESS1) && 
-                (start->position->look(r1 + 1, c1 + 1 - 'A') == BLACK_SQUARE)) {
-                    moves_c[count * 2] = c1, moves_r[count * 2] = r1, moves_c[(count * 2) + 1] = c1 + 1, 
-                    moves_r[(count * 2) + 1] = r1 + 1;
-                    count++;
-                }
-                if ((r1 < DIMEN_LESS1) && (c1 - 'A' > 0) &&
-                (start->position->look(r1 + 1, c1 - 1 - 'A') == BLACK_SQUARE)) {
-                    moves_c[count * 2] = c1, moves_r[count * 2] = r1, moves_c[(count * 2) + 1] = c1 - 1, 
-                    moves_r[(count * 2) + 1] = r1 + 1;
-                    count++;
-                }
-            } else {
-                if ((r1 < DIMEN - 2) && (c1 - 'A' < DIMEN - 2) && 
-                ((start->position->look(r1 + 1, c1 + 1 - 'A') == WHITE_PIECE) || 
-                (start->position->look(r1 + 1, c1 + 1 - 'A') == WHITE_KING)) &&
-                (start->position->look(r1 + 2, c1 + 2 - 'A') == BLACK_SQUARE)) {
-                    moves_c[count * 2] = c1, moves_r[count * 2] = r1, moves_c[(count * 2) + 1] = c1 + 2, 
-                    moves_r[(count * 2) + 1] = r1 + 2;
-                    count++;
-                }
-                if ((r1 < DIMEN - 2) && (c1 - 'A' > 1) && 
-                ((start->position->look(r1 + 1, c1 - 1 - 'A') == WHITE_PIECE) || 
-                (start->position->look(r1 + 1, c1 - 1 - 'A') == WHITE_KING)) &&
-                (start->position->look(r1 + 2, c1 - 2 - 'A') == BLACK_SQUARE)) {
-                    moves_c[count * 2] = c1, moves_r[count * 2] = r1, moves_c[(count * 2) + 1] = c1 - 2, 
-                    moves_r[(count * 2) + 1] = r1 + 2;
-                    count++;
-                }
-            }
-            
-            //check backwards movements for kings
-            if (start->position->get_place_king_b(i)) {
-                if (!forced) {
-                    if ((r1 > 0) && (c1 - 'A' < DIMEN_LESS1) &&
-                    (start->position->look(r1 - 1, c1 + 1 - 'A') == BLACK_SQUARE)) {
-                        moves_c[count * 2] = c1, moves_r[count * 2] = r1, moves_c[(count * 2) + 1] = c1 + 1, 
-                        moves_r[(count * 2) + 1] = r1 - 1;
-                        count++;
-                    }
-                    if ((r1 > 0) && (c1 - 'A' > 0) &&
-                    (start->position->look(r1 - 1, c1 - 1 - 'A') == BLACK_SQUARE)) {
-                        moves_c[count * 2] = c1, moves_r[count * 2] = r1, moves_c[(count * 2) + 1] = c1 - 1, 
-                        moves_r[(count * 2) + 1] = r1 - 1;
-                        count++;
-                    }
-                } else {
-                    if ((r1 > 1) && (c1 - 'A' < DIMEN - 2) && 
-                    ((start->position->look(r1 - 1, c1 + 1 - 'A') == WHITE_PIECE) || 
-                    (start->position->look(r1 - 1, c1 + 1 - 'A') == WHITE_KING)) &&
-                    (start->position->look(r1 - 2, c1 + 2 - 'A') == BLACK_SQUARE)) {
-                        moves_c[count * 2] = c1, moves_r[count * 2] = r1, moves_c[(count * 2) + 1] = c1 + 2, 
-                        moves_r[(count * 2) + 1] = r1 - 2;
-                        count++;
-                    }
-                    if ((r1 > 1) && (c1 - 'A' > 1) && 
-                    ((start->position->look(r1 - 1, c1 - 1 - 'A') == WHITE_PIECE) || 
-                    (start->position->look(r1 - 1, c1 - 1 - 'A') == WHITE_KING)) &&
-                    (start->position->look(r1 - 2, c1 - 2 - 'A') == BLACK_SQUARE)) {
-                        moves_c[count * 2] = c1, moves_r[count * 2] = r1, moves_c[(count * 2) + 1] = c1 - 2, 
-                        moves_r[(count * 2) + 1] = r1 - 2;
-                        count++;
-                    }
-                }
-            }
-        }
+//a ref to the count integer, an int for the depth left, NA at the root, a ref to a bool set when 
+//the move into the Node crowned a piece, so it's undone with the move, and ints for the lowest score 
+//black is sure of and the highest white is, which a stored bound has to fall outside of to be used
+//returns: an int for the Node's score if it's stored deep enough or the side to move has lost, 
+//otherwise NA
+template <char TURN>
+int AI::fill(Node *start, char moves_c[], int moves_r[], int &count, int depth, bool &restore, 
+int low, int high) {
+    bool jump = diverge;
+    diverge = false; //make sure next fill function called is regular
 
-        b_order(moves_c, moves_r, depth, count);
+    Mem_node *place = memory->find(start->position->get_hash(TURN));
+    if (place != NULL) {
+        int others = (TURN == 'B') ? state->get_num_white() : state->get_num_black();
+        bool usable = (place->bound == EXACT) || ((place->bound == LOWER) && (place->score >= high)) ||
+        ((place->bound == UPPER) && (place->score <= low));
+        if ((((others > 3) && (place->depth >= depth)) || (place->depth == depth)) && (depth != NA) && 
+        (usable))
+            return place->score;
     }
 
-    if (start->position->kinged())
-        restore = true;
-    
-    return NA;
-}
-
-//fill_w, fills move arrays with coordinates, testing all possible movements for each piece in the Board 
-//object's white piece position arrays
-//parameters: pointer to a Node, a char array of column coordinates, an int array of row coordinates, 
-//and a pointer to the count integer
-//returns: void
-int AI::fill_w(Node *start, char moves_c[], int moves_r[], int &count, int depth, bool &restore) {
-    string *look = make_key(*start->position, 'W');
-    unordered_map<string, Mem_node>::iterator place = memory->find(*look);
-    if (place != memory->end()) {
-        count = place->second.children;
-        if ((((state->get_num_black() > 3) && (place->second.depth >= depth)) || 
-        (place->second.depth == depth)) && (depth != NA)) {
-            delete [] moves_c;
-            delete [] moves_r;
-            return place->second.score;
-        } else {
-            for (int i = 0; i < 2 * place->second.children; i++) {
-                moves_c[i] = place->second.child_c[i];
-                moves_r[i] = place->second.child_r[i];
-            }
-            count = place->second.children;
-        }
+    if (jump) {
+        jumps_from<TURN>(*start->position, d_col, d_row, moves_c, moves_r, count);
+        hash_first(place, moves_c, moves_r, count);
     } else {
-        char c1;
-        int r1;
-        bool forced = start->position->forced_take('W'); //check for forced jump
-        if ((!forced) && (!start->position->any_move('B')) && (depth != NA)) {
-            delete [] moves_c;
-            delete [] moves_r;
-            return 9950 + depth; //check for win, value modified by depth
-        }
-        for (int i = 0; i < start->position->get_num_white(); i++) {
-            //iterate through each white piece
-            c1 = start->position->get_place_col_w(i) + 'A';
-            r1 = start->position->get_place_row_w(i);
-            if (!forced) {
-                if ((r1 > 0) && (c1 - 'A' < DIMEN_LESS1) &&
-                (start->position->look(r1 - 1, c1 + 1 - 'A') == BLACK_SQUARE)) {
-                    moves_c[count * 2] = c1, moves_r[count * 2] = r1, moves_c[(count * 2) + 1] = c1 + 1, 
-                    moves_r[(count * 2) + 1] = r1 - 1;
-                    count++;
-                }
-                if ((r1 > 0) && (c1 - 'A' > 0) &&
-                (start->position->look(r1 - 1, c1 - 1 - 'A') == BLACK_SQUARE)) {
-                    moves_c[count * 2] = c1, moves_r[count * 2] = r1, moves_c[(count * 2) + 1] = c1 - 1, 
-                    moves_r[(count * 2) + 1] = r1 - 1;
-                    count++;
-                }
-            } else {
-                if ((r1 > 1) && (c1 - 'A' < DIMEN - 2) && 
-                ((start->position->look(r1 - 1, c1 + 1 - 'A') == BLACK_PIECE) || 
-                (start->position->look(r1 - 1, c1 + 1 - 'A') == BLACK_KING)) &&
-                (start->position->look(r1 - 2, c1 + 2 - 'A') == BLACK_SQUARE)) {
-                    moves_c[count * 2] = c1, moves_r[count * 2] = r1, moves_c[(count * 2) + 1] = c1 + 2, 
-                    moves_r[(count * 2) + 1] = r1 - 2;
-                    count++;
-                }
-                if ((r1 > 1) && (c1 - 'A' > 1) && 
-                ((start->position->look(r1 - 1, c1 - 1 - 'A') == BLACK_PIECE) || 
-                (start->position->look(r1 - 1, c1 - 1 - 'A') == BLACK_KING)) &&
-                (start->position->look(r1 - 2, c1 - 2 - 'A') == BLACK_SQUARE)) {
-                    moves_c[count * 2] = c1, moves_r[count * 2] = r1, moves_c[(count * 2) + 1] = c1 - 2, 
-                    moves_r[(count * 2) + 1] = r1 - 2;
-                    count++;
-                }
-            }
+        generate<TURN>(*start->position, moves_c, moves_r, count);
+        if ((count == 0) && (depth != NA))
+            return (TURN == 'B') ? (-9950 - depth) : (9950 + depth); //a loss, value modified by depth
 
-            //check backwards movements for kings
-            if (start->position->get_place_king_w(i)) {
-                if (!forced) {
-                    if ((r1 < DIMEN_LESS1) && (c1 - 'A' < DIMEN_LESS1) && 
-                    (start->position->look(r1 + 1, c1 + 1 - 'A') == BLACK_SQUARE)) {
-                        moves_c[count * 2] = c1, moves_r[count * 2] = r1, moves_c[(count * 2) + 1] = c1 + 1, 
-                        moves_r[(count * 2) + 1] = r1 + 1;
-                        count++;
-                    }
-                    if ((r1 < DIMEN_LESS1) && (c1 - 'A' > 0) &&
-                    (start->position->look(r1 + 1, c1 - 1 - 'A') == BLACK_SQUARE)) {
-                        moves_c[count * 2] = c1, moves_r[count * 2] = r1, moves_c[(count * 2) + 1] = c1 - 1, 
-                        moves_r[(count * 2) + 1] = r1 + 1;
-                        count++;
-                    }
-                } else {
-                    if ((r1 < DIMEN - 2) && (c1 - 'A' < DIMEN - 2) && 
-                    ((start->position->look(r1 + 1, c1 + 1 - 'A') == BLACK_PIECE) || 
-                    (start->position->look(r1 + 1, c1 + 1 - 'A') == BLACK_KING)) &&
-                    (start->position->look(r1 + 2, c1 + 2 - 'A') == BLACK_SQUARE)) {
-                        moves_c[count * 2] = c1, moves_r[count * 2] = r1, moves_c[(count * 2) + 1] = c1 + 2, 
-                        moves_r[(count * 2) + 1] = r1 + 2;
-                        count++;
-                    }
-                    if ((r1 < DIMEN - 2) && (c1 - 'A' > 1) && 
-                    ((start->position->look(r1 + 1, c1 - 1 - 'A') == BLACK_PIECE) || 
-                    (start->position->look(r1 + 1, c1 - 1 - 'A') == BLACK_KING)) &&
-                    (start->position->look(r1 + 2, c1 - 2 - 'A') == BLACK_SQUARE)) {
-                        moves_c[count * 2] = c1, moves_r[count * 2] = r1, moves_c[(count * 2) + 1] = c1 - 2, 
-                        moves_r[(count * 2) + 1] = r1 + 2;
-                        count++;
-                    }
-                }
-            }   
-        }
-        
-        w_order(moves_c, moves_r, depth, count);
+        ordering.order(moves_c, moves_r, count, depth, hash_first(place, moves_c, moves_r, count));
     }
-    
 
     if (start->position->kinged())
         restore = true;
@@ -642,148 +400,18 @@ int AI::fill_w(Node *start, char moves_c[], int moves_r[], int &count, int depth
     return NA;
 }
 
-//diverge_b, fills the position arrays similarly to the fill functions, but only looks for jumps from the 
-//coordinate placed in the d_col and d_row variables, for when one black piece has multiple options 
-//on a second or further jump
-//parameters: pointer to a Node, a char array of column coordinates, an int array of row coordinates, 
-//and a pointer to the count integer
-//returns: void
-int AI::diverge_b(Node *start, char moves_c[], int moves_r[], int &count, int depth) {
-    diverge = false; //make sure next fill function called is regular
-    string *look = make_key(*start->position, 'B');
-    unordered_map<string, Mem_node>::iterator place = memory->find(*look);
-    if (place != memory->end()) {
-        count = place->second.children;
-        if ((((state->get_num_white() > 3) && (place->second.depth >= depth)) || 
-        (place->second.depth == depth)) && (depth != NA)) {
-            delete [] moves_c;
-            delete [] moves_r;
-            return place->second.score;
-        } else {
-            for (int i = 0; i < 2 * place->second.children; i++) {
-                moves_c[i] = place->second.child_c[i];
-                moves_r[i] = place->second.child_r[i];
-            }
-            count = place->second.children;
-        }
-    } else {
-        char c1 = d_col;
-        int r1 = d_row;
-        
-        //check all possible jumps from a single square
-        if (start->position->simple_check(c1, r1, c1 + 2, r1 + 2, 'B')) {
-            moves_c[count * 2] = c1, moves_r[count * 2] = r1, moves_c[(count * 2) + 1] = c1 + 2, 
-            moves_r[(count * 2) + 1] = r1 + 2;
-            count++;
-        }
-        if (start->position->simple_check(c1, r1, c1 + 2, r1 - 2, 'B')) {
-            moves_c[count * 2] = c1, moves_r[count * 2] = r1, moves_c[(count * 2) + 1] = c1 + 2, 
-            moves_r[(count * 2) + 1] = r1 - 2;
-            count++;
-        }
-        if (start->position->simple_check(c1, r1, c1 - 2, r1 + 2, 'B')) {
-            moves_c[count * 2] = c1, moves_r[count * 2] = r1, moves_c[(count * 2) + 1] = c1 - 2, 
-            moves_r[(count * 2) + 1] = r1 + 2;
-            count++;
-        }
-        if (start->position->simple_check(c1, r1, c1 - 2, r1 - 2, 'B')) {
-            moves_c[count * 2] = c1, moves_r[count * 2] = r1, moves_c[(count * 2) + 1] = c1 - 2, 
-            moves_r[(count * 2) + 1] = r1 - 2;
-            count++;
-        }
-    }
-    
-    return NA;
-}
-
-//diverge_w, fills the position arrays similarly to the fill functions, but only looks for jumps from the 
-//coordinate placed in the d_col and d_row variables, for when one white piece has multiple options 
-//on a second or further jump
-//parameters: pointer to a Node, a char array of column coordinates, an int array of row coordinates, 
-//and a pointer to the count integer
-//returns: void
-int AI::diverge_w(Node *start, char moves_c[], int moves_r[], int &count, int depth) {
-    diverge = false; //make sure next fill function called is regular
-    string *look = make_key(*start->position, 'W');
-    unordered_map<string, Mem_node>::iterator place = memory->find(*look);
-    if (place != memory->end()) {
-        count = place->second.children;
-        if (place->second.depth >= depth) {
-            delete [] moves_c;
-            delete [] moves_r;
-            return place->second.score;
-        } else {
-            for (int i = 0; i < 2 * place->second.children; i++) {
-                moves_c[i] = place->second.child_c[i];
-                moves_r[i] = place->second.child_r[i];
-            }
-            count = place->second.children;
-        }
-    } else {
-        char c1 = d_col;
-        int r1 = d_row;
-        
-        //check all possible jumps from a single square
-        if (start->position->simple_check(c1, r1, c1 + 2, r1 + 2, 'W')) {
-            moves_c[count * 2] = c1, moves_r[count * 2] = r1, moves_c[(count * 2) + 1] = c1 + 2, 
-            moves_r[(count * 2) + 1] = r1 + 2;
-            count++;
-        }
-        if (start->position->simple_check(c1, r1, c1 + 2, r1 - 2, 'W')) {
-            moves_c[count * 2] = c1, moves_r[count * 2] = r1, moves_c[(count * 2) + 1] = c1 + 2, 
-            moves_r[(count * 2) + 1] = r1 - 2;
-            count++;
-        }
-        if (start->position->simple_check(c1, r1, c1 - 2, r1 + 2, 'W')) {
-            moves_c[count * 2] = c1, moves_r[count * 2] = r1, moves_c[(count * 2) + 1] = c1 - 2, 
-            moves_r[(count * 2) + 1] = r1 + 2;
-            count++;
-        }
-        if (start->position->simple_check(c1, r1, c1 - 2, r1 - 2, 'W')) {
-            moves_c[count * 2] = c1, moves_r[count * 2] = r1, moves_c[(count * 2) + 1] = c1 - 2, 
-            moves_r[(count * 2) + 1] = r1 - 2;
-            count++;
-        }
-    }
-    
-    return NA;
-}
-
-//fill_multi, helper function to multi, similar to the other fill functions, but only looks for jumps from a 
-//particular square, indicated in the parameters
-//parameters: a char array of column coordinates, and int array of row coordinates, an int ref to  
-//count, an int ref to make, a char and int for the particular square, a string for the color of the AI
-//returns: void
-void AI::fill_multi(char moves_c[], int moves_r[], int &count, char c1, int r1, char color) {
-    if (state->check_validity(c1, r1, c1 + 2, r1 + 2, color)) {
-        moves_c[count * 2] = c1, moves_r[count * 2] = r1, moves_c[(count * 2) + 1] = c1 + 2, 
-        moves_r[(count * 2) + 1] = r1 + 2;
-        count++;
-    }
-    if (state->check_validity(c1, r1, c1 + 2, r1 - 2, color)) {
-        moves_c[count * 2] = c1, moves_r[count * 2] = r1, moves_c[(count * 2) + 1] = c1 + 2, 
-        moves_r[(count * 2) + 1] = r1 - 2;
-        count++;
-    }
-    if (state->check_validity(c1, r1, c1 - 2, r1 + 2, color)) {
-        moves_c[count * 2] = c1, moves_r[count * 2] = r1, moves_c[(count * 2) + 1] = c1 - 2, 
-        moves_r[(count * 2) + 1] = r1 + 2;
-        count++;
-    }
-    if (state->check_validity(c1, r1, c1 - 2, r1 - 2, color)) {
-        moves_c[count * 2] = c1, moves_r[count * 2] = r1, moves_c[(count * 2) + 1] = c1 - 2, 
-        moves_r[(count * 2) + 1] = r1 - 2;
-        count++;
-    }
-}
-
-//moving_b, creates Board objects in the children of the passed Node, copying the start Node's 
-//Board and making the corresponding move from the move arrays for black
+//moving, makes the corresponding move from the move arrays for the color given as the template 
+//parameter, in the child of the passed Node, either on a copy of the Node's Board or on the Board 
+//itself, to be taken back once the child is searched
 //parameters: pointer to a Node, a char array of column coordinates, an int array of row coordinates, 
-// a pointer to the count integer and chars and ints for four coordinate points
+//an int ref to the move's place in them, refs to chars and ints for the move's squares, a bool for 
+//whether to copy the Board, and a char ref for the piece taken, if any
 //returns: void
-void AI::moving_b(Node *start, char moves_c[], int moves_r[], int &make, char &c1, char &c2, int 
+template <char TURN>
+void AI::moving(Node *start, char moves_c[], int moves_r[], int &make, char &c1, char &c2, int 
 &r1, int &r2, bool copy, char &taken) {
+    const char OTHER = (TURN == 'B') ? 'W' : 'B';
+
     c1 = moves_c[make * 2];
     r1 = moves_r[make * 2];
     c2 = moves_c[(make * 2) + 1];
@@ -793,585 +421,540 @@ void AI::moving_b(Node *start, char moves_c[], int moves_r[], int &make, char &c
         taken = start->position->look((r1 + r2) / 2, ((c1 + c2) / 2) - 'A');
 
     if (copy) {
-        start->options[make].position = new Board(*start->position); //make child move
+        start->options[make].position = arena->copy(*start->position); //make child move
         start->options[make].position->make_move(c1, r1, c2, r2);
     } else {
         start->position->make_move(c1, r1, c2, r2);
         start->options[make].position = start->position;
     }
 
-    start->options[make].row1 = r1, start->options[make].row2 = r2; //put move coordinates in child
-    start->options[make].col1 = c1, start->options[make].col2 = c2;
-}
-
-//moving_w, creates Board objects in the children of the passed Node, copying the start Node's 
-//Board and making the corresponding move from the move arrays for white
-//parameters: pointer to a Node, a char array of column coordinates, an int array of row coordinates, 
-// a pointer to the count integer and chars and ints for four coordinate points
-//returns: void
-void AI::moving_w(Node *start, char moves_c[], int moves_r[], int &make, char &c1, char &c2, int 
-&r1, int &r2, bool copy, char &taken) {
-    c1 = moves_c[make * 2];
-    r1 = moves_r[make * 2];
-    c2 = moves_c[(make * 2) + 1];
-    r2 = moves_r[(make * 2) + 1];
-
+    //start loading the child's table slot while the repetition and database checks run
+    memory->prefetch(start->options[make].position->get_hash(OTHER));
     if (abs(r2 - r1) == 2)
-        taken = start->position->look((r1 + r2) / 2, ((c1 + c2) / 2) - 'A');
-
-    if (copy) {
-        start->options[make].position = new Board(*start->position); //make child move
-        start->options[make].position->make_move(c1, r1, c2, r2);
-    } else {
-        start->position->make_move(c1, r1, c2, r2);
-        start->options[make].position = start->position;
-    }
+        memory->prefetch(start->options[make].position->get_hash(TURN)); //the jump may go on
 
     start->options[make].row1 = r1, start->options[make].row2 = r2; //put move coordinates in child
     start->options[make].col1 = c1, start->options[make].col2 = c2;
 }
 
-//maximize, compares the evaluated scores of the start Node's children, returning the score of the 
-//maximum one, and also de-allocating the children
+//best_child, finds the best of the start Node's children for the color to move, given as the template
+//parameter, the max for black and the min for white, the first found of any that tie, and stores the
+//Node with its move
 //parameters: pointer to a Node, a char array of column coordinates, an int array of row coordinates, 
-//and an int ref to the make counter
-//returns: an int for the max score
-int AI::maximize(Node *start, char moves_c[], int moves_r[], int count, int depth) {
+//an int for the number of moves, an int for the depth left, a char for whether the score is exact or
+//a bound
+//returns: an int for the best score
+template <char TURN>
+int AI::best_child(Node *start, char moves_c[], int moves_r[], int count, int depth, char bound) {
+    const int SIDE = (TURN == 'B') ? 1 : -1; //scores are for black, so white's best is the lowest
     Mem_node temp;
-    int hold;
-
-    int place[45];
-    for (int k = 0; k < count; k++)
-        place[k] = k;
 
+    int choice = 0;
     for (int i = 1; i < count; i++) {
-        for (int j = i; j > 0; j--) {
-            if (start->options[place[j]].score > start->options[place[j - 1]].score) {
-                hold = place[j];
-                place[j] = place[j - 1];
-                place[j - 1] = hold;
-            } else {
-                break;
-            }
-        }
+        if (SIDE * start->options[i].score > SIDE * start->options[choice].score)
+            choice = i;
     }
 
-    temp.children = count;
-    for (int i = 0; i < count; i++) {
-        temp.child_c[2 * i] = moves_c[2 * place[i]];
-        temp.child_c[(2 * i) + 1] = moves_c[2* place[i] + 1];
-        temp.child_r[2 * i] = moves_r[2 * place[i]];
-        temp.child_r[(2 * i) + 1] = moves_r[2 * place[i] + 1];
-    }
+    temp.col1 = moves_c[2 * choice], temp.row1 = moves_r[2 * choice];
+    temp.col2 = moves_c[(2 * choice) + 1], temp.row2 = moves_r[(2 * choice) + 1];
+    temp.depth = depth, temp.bound = bound;
+    temp.score = start->options[choice].score;
+    memory->store(start->position->get_hash(TURN), temp);
 
-    temp.depth = depth;
-    temp.score = start->options[place[0]].score;
-    string *access = make_key(*start->position, 'B');
-    
-    unordered_map<string, Mem_node>::iterator stored = memory->find(*access);
-    if (stored != memory->end()) {
-            if (stored->second.depth < depth) {
-                memory->erase(*access);
-                memory->emplace_hint(stored, *access, temp);
-            }
-    } else {
-        memory->emplace(*access, temp);
-    }
-
-    delete [] start->options; //delete array of pointers itself
-    delete [] moves_r; //delete stored move coordinates
-    delete [] moves_c;
     return temp.score;
 }
 
-//minimize, compares the evaluated scores of the start Node's children, returning the score of the 
-//minimum one, and also de-allocating the children
-//parameters: pointer to a Node, a char array of column coordinates, an int array of row coordinates, 
-//and an int ref to the make counter
-//returns: an int for the min score
-int AI::minimize(Node *start, char moves_c[], int moves_r[], int count, int depth) {
-    Mem_node temp;
-    int hold;
-
-    int place[45];
-    for (int k = 0; k < count; k++)
-        place[k] = k;
-
-    for (int i = 1; i < count; i++) {
-        for (int j = i; j > 0; j--) {
-            if (start->options[place[j]].score < start->options[place[j - 1]].score) {
-                hold = place[j];
-                place[j] = place[j - 1];
-                place[j - 1] = hold;
-            } else {
-                break;
-            }
-        }
-    }
-
-    temp.children = count;
-    for (int i = 0; i < count; i++) {
-        temp.child_c[2 * i] = moves_c[2 * place[i]];
-        temp.child_c[(2 * i) + 1] = moves_c[2* place[i] + 1];
-        temp.child_r[2 * i] = moves_r[2 * place[i]];
-        temp.child_r[(2 * i) + 1] = moves_r[2 * place[i] + 1];
-    }
-
-    temp.depth = depth;
-    temp.score = start->options[place[0]].score;
-    string *access = make_key(*start->position, 'W');
-    
-    unordered_map<string, Mem_node>::iterator stored = memory->find(*access);
-    if (stored != memory->end()) {
-            if (stored->second.depth < depth) {
-                memory->erase(*access);
-                memory->emplace_hint(stored, *access, temp);
-            }
-    } else {
-        memory->emplace(*access, temp);
-    }
-
-    delete [] start->options; //delete array of pointers itself
-    delete [] moves_r; //delete stored move coordinates
-    delete [] moves_c;
-    return temp.score;
-}
-
-//closeness, finds the average distance between the kings of the selected color and the nearest 
-//opposing king
-//parameters: a ref to a Board, and a string for the color of the kings to measure distance of nearest
-//opponent from
-//returns: a double for the average king minimum distance
-double AI::closeness(Board &ref, char color) {
-    double total = 0; //sum of distances
-    double kings = 0;
-    int num_b = ref.get_num_black(), num_w = ref.get_num_white();
-
-    bool hold = false;
-    if (ref.look(0, 0) == BLANK)
-        hold = true;
-    for (int i = 0; i < DIMEN; i++) {
-        for (int j = hold; j < DIMEN; j += 2) {
-            if ((color == 'W') && (ref.look(i, j) == WHITE_KING)) {
-                if (proximity(i, j, 'W', ref, num_b, num_w) > 2)
-                    total += proximity(i, j, 'W', ref, num_b, num_w);
-                kings++;
-            } else if ((color == 'B') && (ref.look(i, j) == BLACK_KING)) {
-                if (proximity(i, j, 'B', ref, num_b, num_w) > 2)
-                    total += proximity(i, j, 'B', ref, num_b, num_w);
-                kings++;
-            }
-        }
-        hold = (!hold);
-    }
-    
-    return (total/kings);
-}
-
-//select, helper function to move, finds the optimal move once game-tree evaluations are completed,
-//then sets the make variable to the array number of the optimal child
-//parameters: a Node pointer, an int ref to count, an int ref to make, a string for the color of the AI
-//returns: void
-int AI::select(Node *start, int count, int make, char color) {
-    (void) color;
-
-    int rando[150];
-    int num_same = 0; //number of possible moves with the same score
-
-    int max = NA;
-    for (int i = 0; i < count; i++) {
-        if (start->options[i].score > max) {
-            max = start->options[i].score;
-            make = i;
-            num_same = 0;
-            rando[num_same] = i; //new highest's number added to first position in randomization array
-        } else if (start->options[i].score > max) {
-            num_same++;
-            rando[num_same] = i; //add later tied moves' child array number to randomization array
-        }
+//quiesce, scores a position at the horizon by playing out the takes from it, so a position isn't 
+//scored in the middle of an exchange. Since takes are forced, the side to move, given as the template
+//parameter, can only stand pat, taking the static score, when it has none, and the takes are searched 
+//with alpha-beta cutoffs.
+//parameters: a ref to the Board, ints for the lowest score black is already sure of and the highest 
+//white is, and an int for the depth of the position
+//returns: an int for the score
+template <char TURN>
+int AI::quiesce(Board &ref, int alpha, int beta, int depth) {
+    const char OTHER = (TURN == 'B') ? 'W' : 'B';
+    nodes++;
+
+    if (!ref.forced_take<TURN>()) {
+        //a side that can't move has lost, otherwise the position is quiet
+        if (!ref.any_move(OTHER))
+            return (TURN == 'B') ? (-9950 - depth) : (9950 + depth);
+
+        return eval->calc(ref);
+    }
+
+    int best = (TURN == 'B') ? -10000 : 10000;
+    int num = (TURN == 'B') ? ref.get_num_black() : ref.get_num_white();
+    for (int i = 0; i < num; i++) {
+        char c1 = ref.get_place_col(i, TURN) + 'A';
+        int r1 = ref.get_place_row(i, TURN);
+        if (take_all<TURN>(ref, c1, r1, alpha, beta, depth, best))
+            break;
     }
 
-    //choose randomly among best moves, with extra weighting for ones that progress the game by 
-    //reducing closeness value
-    return rando[rand() % (num_same + 1)];
+    return best;
 }
 
-//select_second, helper function to move, finds a best move if the usual highest-scoring ones are 
-//reduced in score by 30, getting a slightly sub-optimal choice to break repetitions, sets make to it
-//parameters: a Node pointer, an int ref to count, an int ref to make, a string for the color of the AI
-//returns: void
-int AI::select_second(Node *start, int count, int make) {
-    int rando[150];
-    int max = -10001;
-    int num_same = 0; //number of possible moves with the same score
-
-    //find max score
-    for (int i = 0; i < count; i++) {
-        if (start->options[i].score > max)
-            max = start->options[i].score;
-    }
+//take_all, recursive helper to quiesce, plays each take by one piece through to the end of its 
+//multiple jump, and searches the takes from the position after it
+//parameters: a ref to the Board, a char and an int for the column and row of the piece, refs to the
+//window and to the best score so far, and an int for the depth
+//returns: a bool for whether a take was good enough to cut off the search
+template <char TURN>
+bool AI::take_all(Board &ref, char c1, int r1, int &alpha, int &beta, int depth, int &best) {
+    const char OTHER = (TURN == 'B') ? 'W' : 'B';
 
-    //set all max scores to max - 100, so the best sub-optimal move can be chosen, but only if the AI 
-    //isn't badly losing
-    for (int i = 0; i < count; i++) {
-        if ((start->options[i].score >= max - 100) && (max > -120))
-            start->options[i].score = max - 100;
-    }
+    for (int dir = 0; dir < 4; dir++) {
+        int r2 = r1 + (((dir / 2) == 0) ? -2 : 2);
+        char c2 = c1 + (((dir % 2) == 0) ? -2 : 2);
+        if (!ref.simple_check<TURN>(c1, r1, c2, r2))
+            continue;
 
-    max = -10001;
-    for (int i = 0; i < count; i++) {
-        start->options[i].score += rand() % 5;
-        
-        if (start->options[i].score > max) {
-            max = start->options[i].score;
-            make = i;
-            num_same = 0;
-            rando[num_same] = i; //new highest's number added to first position in randomization array
-        } else if (start->options[i].score == max) {
-            num_same++;
-            rando[num_same] = i; //add later tied moves' child array number to randomization array
+        Board next(ref);
+        next.make_move(c1, r1, c2, r2);
+        if ((next.jump_possible<TURN>(c2, r2)) && (!next.kinged())) {
+            if (take_all<TURN>(next, c2, r2, alpha, beta, depth, best))
+                return true;
+            continue;
         }
-    }
-
-    //choose randomly among best sub-optimal moves, with extra weighting for ones that progress the
-    //game by reducing closeness value
-    return rando[rand() % (num_same + 1)];
-}
-
-string* AI::make_key(Board &ref, char turn) {
-    string *hold = ref.get_key();
-    hold->back() = turn;
-    
-    return hold;
-}
-
-void AI::b_order(char moves_c[], int moves_r[], int depth, int count) {
-    if (depth == NA)
-        return;
-
-    char tempc1, tempc2;
-    int tempr1, tempr2, priority = 0;
-    for (int i = count - 1; i > 0; i--) {
-        if ((moves_c[2 * i] == killer_c[depth * 2]) && (moves_c[2 * i + 1] == killer_c[depth * 2 + 1]) && 
-        (moves_r[2 * i] == killer_r[depth * 2]) && (moves_r[2 * i + 1] == killer_r[depth * 2 + 1])) {
-            tempc1 = moves_c[2 * i];
-            tempc2 = moves_c[2 * i + 1];
-            moves_c[2 * i] = moves_c[0];
-            moves_c[2 * i + 1] = moves_c[1];
-            moves_c[0] = tempc1;
-            moves_c[1] = tempc2;
-
-            tempr1 = moves_r[2 * i];
-            tempr2 = moves_r[2 * i + 1];
-            moves_r[2 * i] = moves_r[0];
-            moves_r[2 * i + 1] = moves_r[1];
-            moves_r[0] = tempr1;
-            moves_r[1] = tempr2;
-
-            priority++;
 
-            break;
+        int score = quiesce<OTHER>(next, alpha, beta, depth + 1);
+        if (TURN == 'B') {
+            best = max(best, score);
+            alpha = max(alpha, score);
+        } else {
+            best = min(best, score);
+            beta = min(beta, score);
         }
-    }
 
-    for (int i = priority + 1; i < count; i++) {
-        for (int j = i; j > priority; j--) {
-            if ((history[depth][(moves_c[2 * j] - 'A') * DIMEN + moves_r[2 * j]][(moves_c[2 * j + 1] - 'A') * 
-            DIMEN + moves_r[2 * j + 1]]) < (history[depth][(moves_c[2 * (j - 1)] - 'A') * 
-            DIMEN + moves_r[2 * (j - 1)]][(moves_c[2 * (j - 1) + 1] - 'A') * 
-            DIMEN + moves_r[2 * (j - 1) + 1]])) {
-                tempc1 = moves_c[2 * j];
-                tempc2 = moves_c[2 * j + 1];
-                moves_c[2 * j] = moves_c[2 * (j - 1)];
-                moves_c[2 * j + 1] = moves_c[2 * (j - 1) + 1];
-                moves_c[2 * (j - 1)] = tempc1;
-                moves_c[2 * (j - 1) + 1] = tempc2;
-    
-                tempr1 = moves_r[2 * j];
-                tempr2 = moves_r[2 * j + 1];
-                moves_r[2 * j] = moves_r[2 * (j - 1)];
-                moves_r[2 * j + 1] = moves_r[2 * (j - 1) + 1];
-                moves_r[2 * (j - 1)] = tempr1;
-                moves_r[2 * (j - 1) + 1] = tempr2;
-            } else {
-                break;
-            }
-        }
+        if (alpha >= beta)
+            return true;
     }
-}
 
-void AI::w_order(char moves_c[], int moves_r[], int depth, int count) {
-    if (depth == NA)
-        return;
-    
-    char tempc1, tempc2;
-    int tempr1, tempr2, priority = 0;
-    for (int i = count - 1; i > 0; i--) {
-        if ((moves_c[2 * i] == killer_c[depth * 2]) && (moves_c[2 * i + 1] == killer_c[depth * 2 + 1]) && 
-        (moves_r[2 * i] == killer_r[depth * 2]) && (moves_r[2 * i + 1] == killer_r[depth * 2 + 1])) {
-            tempc1 = moves_c[2 * i];
-            tempc2 = moves_c[2 * i + 1];
-            moves_c[2 * i] = moves_c[0];
-            moves_c[2 * i + 1] = moves_c[1];
-            moves_c[0] = tempc1;
-            moves_c[1] = tempc2;
-
-            tempr1 = moves_r[2 * i];
-            tempr2 = moves_r[2 * i + 1];
-            moves_r[2 * i] = moves_r[0];
-            moves_r[2 * i + 1] = moves_r[1];
-            moves_r[0] = tempr1;
-            moves_r[1] = tempr2;
-
-            priority++;
-
-            break;
-        }
-    }
+    return false;
+}
 
-    for (int i = priority + 1; i < count; i++) {
-        for (int j = i; j > priority; j--) {
-            if ((history[depth][(moves_c[2 * j] - 'A') * DIMEN + moves_r[2 * j]][(moves_c[2 * j + 1] - 'A') * 
-            DIMEN + moves_r[2 * j + 1]]) < (history[depth][(moves_c[2 * (j - 1)] - 'A') * 
-            DIMEN + moves_r[2 * (j - 1)]][(moves_c[2 * (j - 1) + 1] - 'A') * 
-            DIMEN + moves_r[2 * (j - 1) + 1]])) {
-                tempc1 = moves_c[2 * j];
-                tempc2 = moves_c[2 * j + 1];
-                moves_c[2 * j] = moves_c[2 * (j - 1)];
-                moves_c[2 * j + 1] = moves_c[2 * (j - 1) + 1];
-                moves_c[2 * (j - 1)] = tempc1;
-                moves_c[2 * (j - 1) + 1] = tempc2;
-    
-                tempr1 = moves_r[2 * j];
-                tempr2 = moves_r[2 * j + 1];
-                moves_r[2 * j] = moves_r[2 * (j - 1)];
-                moves_r[2 * j + 1] = moves_r[2 * (j - 1) + 1];
-                moves_r[2 * (j - 1)] = tempr1;
-                moves_r[2 * (j - 1) + 1] = tempr2;
-            } else {
-                break;
+//from_book, looks the position up in the opening book and plays a move from it, after checking it's 
+//legal in case of a hash collision
+//parameters: NA
+//returns: a bool for whether a book move was played
+bool AI::from_book() {
+    Book_entry entry;
+    if ((!book_on) || (!book->loaded()) || (!book->choose(state->get_hash('B'), rng, entry)))
+        return false;
+
+    //book moves are stored in the standard orientation
+    int c1 = entry.col1, c2 = entry.col2;
+    if (state->look(0, 0) != BLANK)
+        c1 = DIMEN_LESS1 - c1, c2 = DIMEN_LESS1 - c2;
+
+    if (!state->check_validity(c1 + 'A', entry.row1, c2 + 'A', entry.row2, 'B'))
+        return false;
+
+    col1 = c1 + 'A', row1 = entry.row1, col2 = c2 + 'A', row2 = entry.row2;
+    state->make_move(col1, row1, col2, row2);
+
+    return true;
+}
+
+//expect_reply, plays the opponent's reply stored in the transposition table by the last search, 
+//following it through a multiple jump, with the first jump that goes on where the table runs out
+//parameters: a ref to the board to play it on, with white to move
+//returns: a bool for whether a reply was found, leaving black a move to make
+bool AI::expect_reply(Board &ref) {
+    char from_c = 'A';
+    int from_r = 0;
+    bool again = false;
+
+    do {
+        char c1 = 'A', c2 = 'A';
+        int r1 = 0, r2 = 0;
+        Mem_node *place = memory->find(ref.get_hash('W'));
+        if (place != NULL) {
+            c1 = place->col1, r1 = place->row1;
+            c2 = place->col2, r2 = place->row2;
+        }
+
+        if ((!ref.check_validity(c1, r1, c2, r2, 'W')) || ((again) && ((c1 != from_c) || 
+        (r1 != from_r)))) {
+            if (!again)
+                return false;
+
+            //the jump has to go on somewhere
+            c1 = from_c, r1 = from_r;
+            for (int dir = 0; dir < 4; dir++) {
+                r2 = from_r + (((dir / 2) == 0) ? -2 : 2);
+                c2 = from_c + (((dir % 2) == 0) ? -2 : 2);
+                if (ref.check_validity(c1, r1, c2, r2, 'W'))
+                    break;
             }
         }
-    }
-}
 
-void AI::concurrent_table_free(unordered_map<string, Mem_node>* temp) {
-    temp->clear();
-    delete temp;
-}
+        ref.make_move(c1, r1, c2, r2);
+        again = (abs(r2 - r1) == 2) && (ref.jump_possible(c2, r2, 'W')) && (!ref.kinged());
+        from_c = c2, from_r = r2;
+    } while (again);
 
-inline void AI::update_killer(char c1, int r1, char c2, int r2, int depth) {
-    killer_c[2 * depth] = c1, killer_c[2 * depth + 1] = c2;
-    killer_r[2 * depth] = r1, killer_r[2 * depth + 1] = r2;
+    return (!ref.check_win('W'));
 }
 
-int AI::deepb(Node *start, int depth) {
+//stop_pondering, stops the ponder search after the opponent played something else, throwing away its 
+//move, and puts back the level's time limit
+//parameters: NA
+//returns: void
+void AI::stop_pondering() {
+    stopped = true;
+    ponderer.join();
+    stopped = false; //the ponder search is over, so the next one can run
+    time_limit = saved_limit;
+    pondering = false, ponder_hit = false;
+}
+
+//reducible, checks whether a move can be searched at reduced depth: a quiet move, not a take, a 
+//crowning or the killer, late in the ordering, with enough depth left below it
+//parameters: a pointer to the Node, chars and ints for the move's columns and rows, an int for its 
+//place in the ordering and an int for the depth of the Node
+//returns: a bool for whether to reduce the move
+bool AI::reducible(Node *start, char c1, int r1, char c2, int r2, int make, int depth) {
+    int left = difficulty - depth;
+    if ((make < LMR_MOVES) || (left < LMR_DEPTH) || (abs(r2 - r1) == 2) || 
+    (start->options[make].position->kinged()))
+        return false;
+
+    return (!ordering.is_killer(c1, r1, c2, r2, left));
+}
+
+//deep, searches a position with the color given as the template parameter to move, down to the 
+//difficulty level, with alpha-beta cutoffs. Scores are always for black, so black takes the highest
+//and white the lowest, and each comparison is made on the score times the side's sign, which lets
+//one search play both.
+//parameters: pointer to the Node, an int for its depth
+//returns: an int for the Node's score
+template <char TURN>
+int AI::deep(Node *start, int depth) {
+    const int SIDE = (TURN == 'B') ? 1 : -1; //sign that makes the side to move's best the highest
     int count = 0, make = 0; //number of possible moves, number iterated through so far
     char c1, c2, taken = 'X'; //position variables
     int r1, r2;
-    int *moves_r = new int[180]; //arrays with square locations for possible moves
-    char *moves_c = new char[180];
     bool restore = false;
 
-    if ((depth < difficulty - 10) && (time(NULL) - start_time >= time_limit)) {
-        delete [] moves_c;
-        delete [] moves_r;
-        return 0;
-    }
+    nodes++;
 
-    cutoffs[depth + 1] = -10000;
-    
-    if (diverge) {
-        int cut = diverge_b(start, moves_c, moves_r, count, difficulty - depth); //moves for a multi jump turn
-        if (cut != NA)
-            return cut;
-    } else {
-        int cut = fill_b(start, moves_c, moves_r, count, difficulty - depth, restore); //fill in possible moves
-        if (cut != NA)
-            return cut;
+    if (halted(depth)) {
+        diverge = false;
+        return 0;
     }
 
-    start->options = new Node[count]; //create subtrees for each possible move
+    if ((!diverge) && (repeated(*start->position, TURN, depth)))
+        return 0; //a draw, since either side can keep repeating
 
-    while (make < count) {
-        moving_b(start, moves_c, moves_r, make, c1, c2, r1, r2, false, taken); //fill child Node
-
-        evaluate_move_b(start, c1, r1, c2, r2, make, depth);
+    if (!diverge) {
+        int known = probe(*start->position, TURN, 'B'); //exact score once few pieces are left
+        if (known != NA)
+            return known;
+    }
 
-        start->position->reverse_move(c1, r1, c2, r2, taken, restore);
+    int *moves_r = arena->make<int>(180); //arrays with square locations for possible moves
+    char *moves_c = arena->make<char>(180);
 
-        if (start->options[make].score > cutoffs[depth + 1])
-                cutoffs[depth + 1] = start->options[make].score; //set alpha-beta value
+    //a null window for a reduced move
+    cutoffs[depth + 1] = (scout) ? (cutoffs[depth] - SIDE) : (-SIDE * 10000);
+    scout = false;
 
-        if (start->options[make].score >= cutoffs[depth]) {
-            update_killer(c1, r1, c2, r2, difficulty - depth);
-            if (difficulty - depth > 1)
-                history[difficulty - depth][r1 * DIMEN + (c1 - 'A')][r2 * DIMEN + (c2 - 'A')]++;
-            for (int i = make + 1; i < count; i++) {
-                start->options[i].score = start->options[make].score;
-                start->options[i].position = NULL; //prune unevaluated branches after a disqualifying child
-            }
-            make = count - 1;
-        }
-        
-        make++;
-    }
-    if ((depth < difficulty - 10) && (time(NULL) - start_time >= time_limit)) {
-        return 0;
-    } else {
-        return maximize(start, moves_c, moves_r, count, difficulty - depth); //return max of children's scores
-    }
-}
+    //the window in black's terms, the side to move's own bound and the one from the node above
+    int open = cutoffs[depth + 1];
+    int low = (TURN == 'B') ? open : cutoffs[depth], high = (TURN == 'B') ? cutoffs[depth] : open;
 
-int AI::deepw(Node *start, int depth) {
-    int count = 0, make = 0; //number of possible moves, number iterated through so far
-    char c1, c2, taken = 'X'; //position variables
-    int r1, r2;
-    int *moves_r = new int[180]; //arrays with square locations for possible moves
-    char *moves_c = new char[180];
-    bool restore = false;
+    int cut = fill<TURN>(start, moves_c, moves_r, count, difficulty - depth, restore, low, high); //fill in possible moves
+    if (cut != NA)
+        return cut;
 
-    if ((depth < difficulty - 10) && (time(NULL) - start_time >= time_limit)) {
-        delete [] moves_c;
-        delete [] moves_r;
-        return 0;
-    }
+    if (follow_pv)
+        pv_first(moves_c, moves_r, count);
 
-    cutoffs[depth + 1] = 10000;
+    start->options = arena->make<Node>(count); //create subtrees for each possible move
+    int best = -SIDE * 10000;
+    char bound = EXACT;
 
-    if (diverge) {
-        int cut = diverge_w(start, moves_c, moves_r, count, difficulty - depth); //moves for a multi jump turn
-        if (cut != NA)
-            return cut;
-    } else {
-        int cut = fill_w(start, moves_c, moves_r, count, difficulty - depth, restore); //fill in possible moves
-        if (cut != NA)
-            return cut;
-    }
+    while (make < count) {
+        moving<TURN>(start, moves_c, moves_r, make, c1, c2, r1, r2, false, taken); //fill child Node
 
-    start->options = new Node[count]; //create subtrees for each possible move
+        bool full = true;
+        if (reducible(start, c1, r1, c2, r2, make, depth)) {
+            //a quiet move ordered late is tried a ply shallower, and only searched in full if it beats
+            //the side's bound
+            difficulty--, scout = true;
+            evaluate_move<TURN>(start, c1, r1, c2, r2, make, depth);
+            difficulty++, scout = false;
+            full = (SIDE * start->options[make].score > SIDE * cutoffs[depth + 1]);
+        }
 
-    while (make < count) {
-        moving_w(start, moves_c, moves_r, make, c1, c2, r1, r2, false, taken); //fill child Node
-        
-        evaluate_move_w(start, c1, r1, c2, r2, make, depth);
+        if (full)
+            evaluate_move<TURN>(start, c1, r1, c2, r2, make, depth);
 
         start->position->reverse_move(c1, r1, c2, r2, taken, restore);
 
-        if (start->options[make].score < cutoffs[depth + 1])
+        int score = SIDE * start->options[make].score;
+        if (score > SIDE * best) {
+            best = start->options[make].score;
+            update_pv(c1, r1, c2, r2);
+        }
+
+        if (score > SIDE * cutoffs[depth + 1])
             cutoffs[depth + 1] = start->options[make].score; //set alpha-beta value
 
-        if (start->options[make].score <= cutoffs[depth]) {
-            update_killer(c1, r1, c2, r2, difficulty - depth);
-            if (difficulty - depth > 1)
-                history[difficulty - depth][r1 * DIMEN + (c1 - 'A')][r2 * DIMEN + (c2 - 'A')]++;
+        if (score >= SIDE * cutoffs[depth]) {
+            bound = (TURN == 'B') ? LOWER : UPPER; //the moves left could only do better
+            ordering.cutoff(c1, r1, c2, r2, difficulty - depth);
             for (int i = make + 1; i < count; i++) {
                 start->options[i].score = start->options[make].score;
                 start->options[i].position = NULL; //prune unevaluated branches after a disqualifying child
             }
             make = count - 1;
         }
-
+        
         make++;
     }
 
-    if ((depth < difficulty - 10) && (time(NULL) - start_time >= time_limit)) {
-        return 0;
+    if (halted(depth)) {
+        return 0; //scores are incomplete, so nothing is stored
     } else {
-        return minimize(start, moves_c, moves_r, count, difficulty - depth); //return max of children's scores
+        if ((bound == EXACT) && (SIDE * best <= SIDE * open))
+            bound = (TURN == 'B') ? UPPER : LOWER; //nothing beat a null window, so it's only a bound
+
+        return best_child<TURN>(start, moves_c, moves_r, count, difficulty - depth, bound); //best of children's scores
     }
 }
 
-void AI::iterative_deepening(bool sub) {
+void AI::iterative_deepening() {
     if (difficulty > 3) {
         difficulty--;
-        move(sub, false);
+        search(false);
         difficulty++;
     }
 }
 
-void AI::manage_memory() {
-    if ((clear) || (memory->size() * sizeof(Mem_node) > 4000000000)) {
-        unordered_map<string, Mem_node> *temp = memory;
-        memory = new unordered_map<string, Mem_node>;
-        memory->reserve(4000000000 / sizeof(Mem_node));
-        if (background.joinable())
-            background.join();
-
-        background = thread(&AI::concurrent_table_free, this, temp);
-        background.detach();
-        
-        clear = false;
-    }
-}
-
-void AI::clear_history() {
-    for (int i = 0; i < 100; i++) {
-        killer_c[i] = DIMEN + 'A';
-        killer_r[i] = DIMEN;
-        for (int j = 0; j < 64; j++) {
-            for (int k = 0; k < 64; k++) {
-                history[i][j][k] = 0;
-            }
-        }
+void AI::pre_move(bool go) {
+    if (go) {
+        start_time = time(NULL);
+        nodes = 0, completed = 0, ran_out = false;
+        deadline = (movetime > 0) ? clock_ms() + movetime : 0;
     }
-}
 
-void AI::pre_move(bool sub, bool go) {
     if (go)
-        start_time = time(NULL);
+        memory->next_age(); //entries from earlier moves can be overwritten from now on
 
-    if (sub)
-        repeat = true; //fully score each move from root
+    if (go)
+        rebase_seed();
 
     if (go)
-        manage_memory();
+        ordering.age();
 
     if (go)
-        clear_history();
+        arena->reset(); //nothing is left from the last decision's search
 }
 
-void AI::evaluate_move_b(Node *start, char c1, int r1, char c2, int r2, int make, int depth) {
-    if ((abs(r2 - r1) == 2) && (start->options[make].position->jump_possible(c2, r2, 'B')) && 
-    (!start->options[make].position->kinged())) {
-        diverge = true;
-        d_col = c2, d_row = r2;
-        start->options[make].score = deepb(&start->options[make], depth); //recurse for multiple jumps
-    } else if (depth < difficulty - 1) {
-        start->options[make].score = deepw(&start->options[make], depth + 1); //evaluate responses
-    } else {
-        start->options[make].score = calc(*start->options[make].position); //get score for this position
-    }
+//evaluate_move, scores the child made by a move of the color given as the template parameter, by
+//going on with a multiple jump, searching the other side's replies, or settling the takes at the
+//horizon
+//parameters: pointer to the Node, chars and ints for the move's columns and rows, an int for the 
+//child's place in the Node's options and an int for the Node's depth
+//returns: void
+template <char TURN>
+void AI::evaluate_move(Node *start, char c1, int r1, char c2, int r2, int make, int depth) {
+    const char OTHER = (TURN == 'B') ? 'W' : 'B';
 
-    (void) c1;
-}
+    ply++;
+    pv_lines[ply].length = 0; //filled in by the child's search, if it gets that far
+    jumping[ply] = (abs(r2 - r1) == 2) && (start->options[make].position->jump_possible<TURN>(c2, r2)) && 
+    (!start->options[make].position->kinged());
 
-void AI::evaluate_move_w(Node *start, char c1, int r1, char c2, int r2, int make, int depth) {
-    if ((abs(r2 - r1) == 2) && (start->options[make].position->jump_possible(c2, r2, 'W')) && 
-    (!start->options[make].position->kinged())) {
+    Arena::Mark subtree = arena->mark(); //what the child's search takes is given back after it
+    if (jumping[ply]) {
         diverge = true;
         d_col = c2, d_row = r2;
-        start->options[make].score = deepw(&start->options[make], depth); //recurse for multiple jumps
+        start->options[make].score = deep<TURN>(&start->options[make], depth); //recurse for multiple jumps
     } else if (depth < difficulty - 1) {
-        start->options[make].score = deepb(&start->options[make], depth + 1); //evaluate responses
+        start->options[make].score = deep<OTHER>(&start->options[make], depth + 1); //evaluate responses
     } else {
-        start->options[make].score = calc(*start->options[make].position); //get score for this position
+        //settle any takes before scoring the position, within the window of the node above, black's
+        //bound being alpha and white's beta
+        int alpha = (TURN == 'B') ? cutoffs[depth + 1] : cutoffs[depth];
+        int beta = (TURN == 'B') ? ((depth > 0) ? cutoffs[depth] : 10000) : cutoffs[depth + 1];
+        start->options[make].score = quiesce<OTHER>(*start->options[make].position, alpha, beta, depth + 1);
     }
 
+    arena->rewind(subtree);
+    ply--;
+    follow_pv = false; //only the first child of a node on the last line can be on it too
+
     (void) c1;
 }
 
-void AI::choose_move(Node *start, int count, int make, bool sub) {
-    if (time(NULL) - start_time < time_limit) {
-        int choice;
-        if (!sub) {
-            choice = select(start, count, make, 'B'); //choose best move, change make value
-        } else {
-            choice = select_second(start, count, make); //choose sub-optimal move, change make value
-        }
+void AI::choose_move(Node *start, int count) {
+    if ((time(NULL) - start_time < time_limit) && (!stopped) && (!ran_out)) {
+        int choice = select(start, count, 'B', false); //choose best move
         
         //set decided move accessible by getter
         row1 = start->options[choice].row1, row2 = start->options[choice].row2;
         col1 = start->options[choice].col1, col2 = start->options[choice].col2;
+        completed = difficulty, best_score = start->options[choice].score;
+
+        //the line expected from here, which also leads the next search
+        ply = 0;
+        pv_lines[1] = root_lines[choice];
+        update_pv(col1, row1, col2, row2);
+        best_line = pv_lines[0];
+        seed = best_line, seed_root = *state;
+
+        if (multi_pv > 1)
+            rank_lines(start, count, choice);
+    }
+}
+
+//root_window, keeps the best root scores so far in a multi-PV search and sets the window the next
+//root move is searched with. Once there are as many as the lines asked for, a move has to beat the 
+//last of them to get in, so searching it against one less than that score gives it an exact score
+//if it does, and only the moves that can't get in are cut off. Before that, every move is searched
+//in full.
+//parameters: an int array of the best scores, highest first, a ref to the number kept, and an int for
+//the score of the move just searched
+//returns: an int for alpha at the root
+int AI::root_window(int top[], int &kept, int score) {
+    if ((kept < multi_pv) || (score > top[kept - 1])) {
+        int i = (kept < multi_pv) ? kept++ : kept - 1;
+        for (; (i > 0) && (top[i - 1] < score); i--)
+            top[i] = top[i - 1];
+        top[i] = score;
+    }
+
+    return (kept == multi_pv) ? (top[kept - 1] - 1) : -10000;
+}
+
+//rank_lines, puts the best root moves of a multi-PV search in order, with their scores and lines, the
+//chosen move first, and the rest by score, keeping the order they were searched in for ties
+//parameters: a Node pointer to the root, an int for the number of moves, an int for the chosen one
+//returns: void
+void AI::rank_lines(Node *start, int count, int choice) {
+    bool used[90] = {false};
+    ranked = 0;
+
+    for (int next = choice; (next != NA) && (ranked < multi_pv); ranked++) {
+        used[next] = true;
+        ply = 0;
+        pv_lines[1] = root_lines[next];
+        update_pv(start->options[next].col1, start->options[next].row1, start->options[next].col2, 
+        start->options[next].row2);
+        ranked_lines[ranked] = pv_lines[0], ranked_scores[ranked] = root_scores[next];
+
+        next = NA;
+        for (int i = 0; i < count; i++) {
+            if ((!used[i]) && ((next == NA) || (root_scores[i] > root_scores[next])))
+                next = i;
+        }
+    }
+}
+
+//halted, checks whether the search should end, because a timed level has run out of time, a limit 
+//set for analysis has been reached, or it's been stopped
+//parameters: an int for the depth of the position being searched
+//returns: a bool for whether to stop searching
+bool AI::halted(int depth) {
+    if ((depth < difficulty - 10) && (time(NULL) - start_time >= time_limit))
+        return true;
+
+    if ((!ran_out) && (((node_limit > 0) && (nodes >= node_limit)) || 
+    ((deadline > 0) && (clock_ms() >= deadline))))
+        ran_out = true;
+
+    return (stopped) || (ran_out);
+}
+
+//get_info, gets the result of the last search: its depth, score, the positions it searched and the
+//line it expects from the position it searched
+//parameters: NA
+//returns: the Search_info, with a depth of 0 if no search has completed
+Search_info AI::get_info() {
+    Search_info info;
+    info.depth = completed, info.score = best_score, info.nodes = nodes;
+    info.pv = best_line;
+
+    //a single line is just the best one
+    info.lines = (multi_pv > 1) ? ranked : 1;
+    info.scores[0] = best_score, info.pv_lines[0] = best_line;
+    for (int i = 1; i < info.lines; i++)
+        info.scores[i] = ranked_scores[i], info.pv_lines[i] = ranked_lines[i];
+
+    return info;
+}
+
+//pv_first, moves the hop the last search expected at this point on its line to the front of the move
+//list, while the search is still following that line
+//parameters: the move arrays, an int for the number of moves in them
+//returns: void
+void AI::pv_first(char moves_c[], int moves_r[], int count) {
+    if (ply < seed.length) {
+        for (int i = 0; i < count; i++) {
+            if ((moves_c[2 * i] == seed.col1[ply]) && (moves_r[2 * i] == seed.row1[ply]) &&
+            (moves_c[(2 * i) + 1] == seed.col2[ply]) && (moves_r[(2 * i) + 1] == seed.row2[ply])) {
+                swap(moves_c[2 * i], moves_c[0]), swap(moves_c[(2 * i) + 1], moves_c[1]);
+                swap(moves_r[2 * i], moves_r[0]), swap(moves_r[(2 * i) + 1], moves_r[1]);
+                return;
+            }
+        }
+    }
+
+    follow_pv = false; //off the line, so the rest of the search isn't on it either
+}
+
+//rebase_seed, starts the line from the last search at the position being searched now, if the game 
+//followed it there, so the next search tries the expected moves first, and drops it if not
+//parameters: NA
+//returns: void
+void AI::rebase_seed() {
+    Board ref(seed_root);
+    char color = 'B';
+    uint64_t key = state->get_hash('B');
+
+    for (int i = 0; i <= seed.length; i++) {
+        if ((color == 'B') && (ref.get_hash('B') == key) && (ref.same(*state))) {
+            seed.length -= i;
+            for (int j = 0; j < seed.length; j++) {
+                seed.col1[j] = seed.col1[j + i], seed.row1[j] = seed.row1[j + i];
+                seed.col2[j] = seed.col2[j + i], seed.row2[j] = seed.row2[j + i];
+                seed.again[j] = seed.again[j + i];
+            }
+            seed_root = *state;
+            return;
+        }
+
+        if (i < seed.length) {
+            ref.make_move(seed.col1[i], seed.row1[i], seed.col2[i], seed.row2[i]);
+            if ((i + 1 == seed.length) || (!seed.again[i + 1]))
+                color = (color == 'B') ? 'W' : 'B';
+        }
+    }
+
+    seed.length = 0;
+}
+
+//update_pv, makes a node's line the hop to its best child so far followed by the child's line, kept 
+//by the number of hops from the root, so each node's line is built from its children's as the search
+//returns up the tree
+//parameters: chars and ints for the columns and rows of the hop
+//returns: void
+void AI::update_pv(char c1, int r1, char c2, int r2) {
+    Search_line &line = pv_lines[ply], &child = pv_lines[ply + 1];
+    bool again = jumping[ply];
+
+    line.col1[0] = c1, line.row1[0] = r1;
+    line.col2[0] = c2, line.row2[0] = r2;
+    line.again[0] = again;
+    line.length = 1;
+    for (int i = 0; (i < child.length) && (line.length < PV_MAX); i++, line.length++) {
+        line.col1[line.length] = child.col1[i], line.row1[line.length] = child.row1[i];
+        line.col2[line.length] = child.col2[i], line.row2[line.length] = child.row2[i];
+        line.again[line.length] = child.again[i];
     }
 }
@@ -8,174 +8,226 @@ One of two AI objects, this one seen as "Thomas."*/
 #include <fstream>
 #include <cstdlib>
 #include <string>
-#include <unordered_map>
 #include <thread>
+#include <atomic>
+#include <functional>
+#include <random>
+#include <vector>
 #include "board.h"
+#include "tablebase.h"
+#include "eval.h"
+#include "engine.h"
+#include "book.h"
+#include "table.h"
+#include "order.h"
 
 using namespace std;
 
 #ifndef AI_H
 #define AI_H
 
-class AI {
+//longest line of play reported by a search
+const int PV_MAX = 32;
+
+//a line of play, as hops, with a flag for hops continuing a multiple jump
+struct Search_line {
+    int length;
+    char col1[PV_MAX], col2[PV_MAX];
+    int row1[PV_MAX], row2[PV_MAX];
+    bool again[PV_MAX];
+};
+
+//most root moves a multi-PV search finds exact scores and lines for
+const int MULTI_PV_MAX = 8;
+
+//progress of a search, reported after each completed depth, with the score for black, and the best
+//root moves, best first, with their scores and lines, just the one unless multi-PV is set
+struct Search_info {
+    int depth, score;
+    long long nodes;
+    Search_line pv;
+    int lines;
+    int scores[MULTI_PV_MAX];
+    Search_line pv_lines[MULTI_PV_MAX];
+};
+
+class AI : public Engine {
     private:
         /***AI state***/
-        
-        //name of AI
-        string name;
 
         //variable for difficulty level
         int difficulty;
 
-        //variables for time limit
-        long long start_time;
-        long long time_limit;
-    
-        /***Structs***/
+        //variables for time limit, read by the search while pondering as they're changed on a hit
+        atomic<long long> start_time;
+        atomic<long long> time_limit;
+
+        //limits for analysis, 0 for none, with the time in milliseconds, and the deadline they set
+        long long node_limit, movetime, deadline;
+
+        //positions searched so far this move
+        long long nodes;
+
+        //set to end the search early by stop, and cleared only by the thread that starts a search, 
+        //before it starts, so a stop sent as it starts isn't lost
+        atomic<bool> stopped;
+
+        //set once the search under way reaches a limit set for analysis
+        bool ran_out;
 
-        //Game tree node
-        struct Node {
-            Board *position;
-            Node *options;
-            int score;
-            char row1, row2;
-            char col1, col2;
-        };
-
-        //stored position node
-        struct Mem_node {
-            char child_c[180];
-            char child_r[180];
-            int score;
-            char children;
-            char depth;
-        };
+        //deepest search completed this move, and its score
+        int completed, best_score;
+
+        //called with each completed depth, if set
+        function<void(const Search_info&)> reporter;
+
+        /***Principal variation***/
+
+        //best line found below each node on the path being searched, by hops from the root, whether 
+        //the hop into each continues a jump, and the hops from the root now
+        Search_line pv_lines[100];
+        bool jumping[100];
+        int ply;
+
+        //line below each root move and its score, and the line expected from the last completed search
+        Search_line root_lines[90];
+        int root_scores[90];
+        Search_line best_line;
+
+        //number of root moves to find exact scores and lines for, and the ones found by the last
+        //completed search, best first
+        int multi_pv, ranked;
+        int ranked_scores[MULTI_PV_MAX];
+        Search_line ranked_lines[MULTI_PV_MAX];
+
+        //line from the last search, leading the move ordering while the search follows it, and the 
+        //position it starts from
+        Search_line seed;
+        Board seed_root;
+        bool follow_pv;
+
+        /***Structs***/
 
         /***History information***/
         
-        //transposition table, stores data from previous move evaluations
-        unordered_map<string, Mem_node> *memory = new unordered_map<string, Mem_node>;
+        //transposition table, stores data from previous move evaluations, kept from move to move
+        Table<Mem_node> *memory;
         
-        //hold last move to cause a beta-cutoff at each level
-        char killer_c[100] = {DIMEN + 'A'};
-        int killer_r[100] = {DIMEN};
-
-        int history[100][64][64];
+        //killer moves and history scores for ordering moves
+        Move_order ordering;
 
         int cutoffs[100];
 
-        /***~Threading~***/
+        //set while searching a reduced move, so the node below starts with a null window
+        bool scout;
 
-        //thread for background work
-        thread background;
+        //opening book, consulted before searching unless turned off
+        Book *book;
+        bool book_on;
 
-        /***Game and move state***/
-        
-        //board held by AI to make decisions
-        Board *state;
+        /***~Threading~***/
 
-        //position variables for chosen move
-        char col1, col2;
-        int row1, row2;
+        //thread searching the position expected after the opponent's reply, while they think
+        thread ponderer;
 
-        //restrictions on possible moves for evaluating multiple jumps
-        bool diverge, repeat;
+        //whether to ponder, whether the ponder search is running, and whether the opponent played the
+        //reply it expected, the last two read by the ponder search as they're set on the main thread
+        bool ponder_on;
+        atomic<bool> pondering, ponder_hit;
 
-        //hold piece position for divergent multiple jumps
-        char d_col;
-        int d_row;
+        //position expected after the opponent's reply
+        Board expected;
 
-        //whether or not to clear transposition table at start of next move
-        bool clear;
+        //time limit of the level, which pondering goes without until the opponent moves
+        long long saved_limit;
 
         /***Constants***/
         
         //board size constant
-        const static int DIMEN = 8;
-
-        //other constants
-        const static char WHITE_PIECE = 'r', WHITE_KING = 'R';
-        const static char BLACK_PIECE = 'b', BLACK_KING = 'B';
-        const static char BLANK = ' ', BLACK_SQUARE = '-';
-        const static int NA = -32000;
         const static int DIMEN_LESS1 = 7;
-        
-        //evaluates how favorable a position is to the AI
-        int calc(Board &ref);
 
-        //calculates the distance of a piece from the nearest opposing piece
-        int proximity(int row, int column, char turn, Board &ref, int num_b, int num_w);
+        //deepest search allowed, within the depths the move ordering keeps
+        const static int MAX_DEPTH = 40;
 
-        //finds the average distance between the kings of a given color and the nearest opposing piece
-        double closeness(Board &ref, char color);
+        //moves ordered before this many aren't reduced, nor are moves with less depth left than this
+        const static int LMR_MOVES = 3, LMR_DEPTH = 3;
 
-        //fill the move option arrays for the max node deep functions
-        int fill_b(Node *start, char moves_c[], int moves_r[], int &count, int depth, bool &restore);
+        //default transposition table size, in megabytes
+        const static int HASH_MB = 256;
 
-        //fill the move option arrays for the min node deep functions
-        int fill_w(Node *start, char moves_c[], int moves_r[], int &count, int depth, bool &restore);
+        //kinds of stored score, exact, at least the score, or at most the score, for black
+        const static char EXACT = 0, LOWER = 1, UPPER = 2;
         
-        //fill the move option arrays from only one starting square
-        void fill_multi(char moves_c[], int moves_r[], int &count, char c1, int r1, char color);
-
-        //fill the move options arrays for the max node deep functions for diverging jumps
-        int diverge_b(Node *start, char moves_c[], int moves_r[], int &count, int depth);
-
-        //fill the move options arrays for the min node deep functions for diverging jumps
-        int diverge_w(Node *start, char moves_c[], int moves_r[], int &count, int depth);
-
-        //make the moves on the board from the move arrays for the max nodes
-        void moving_b(Node *start, char moves_c[], int moves_r[], int &make, char &c1, char &c2, 
+        //fill the move option arrays for a color's nodes, only with the jumps on from the last one
+        //when diverge is set, returns the node's score if it's known already
+        template <char TURN>
+        int fill(Node *start, char moves_c[], int moves_r[], int &count, int depth, bool &restore, 
+        int low, int high);
+
+        //make the moves on the board from the move arrays for a color's nodes
+        template <char TURN>
+        void moving(Node *start, char moves_c[], int moves_r[], int &make, char &c1, char &c2, 
         int &r1, int &r2, bool copy, char &taken);
 
-        //make the moves on the board from the move arrays for the min nodes
-        void moving_w(Node *start, char moves_c[], int moves_r[], int &make, char &c1, char &c2, 
-        int &r1, int &r2, bool copy, char &taken);
+        //return the best value for a color at the node, clean up arrays
+        template <char TURN>
+        int best_child(Node *start, char moves_c[], int moves_r[], int count, int depth, char bound);
 
-        //return the max value at the node, clean up arrays
-        int maximize(Node *start, char moves_c[], int moves_r[], int count, int depth);
+        //score a position at the horizon once its takes are played out
+        template <char TURN>
+        int quiesce(Board &ref, int alpha, int beta, int depth);
 
-        //return the min value at the node, clean up arrays
-        int minimize(Node *start, char moves_c[], int moves_r[], int count, int depth);
+        //play each take by one piece to the end of its multiple jump, for quiesce
+        template <char TURN>
+        bool take_all(Board &ref, char c1, int r1, int &alpha, int &beta, int depth, int &best);
 
-        //chooses a move after score evaluations have been made
-        int select(Node *start, int count, int make, char color);
+        //play a move from the opening book, returns false if the position isn't in it
+        bool from_book();
 
-        //same as above, but choose a next best move to avoid repetition
-        int select_second(Node *start, int count, int make);
+        //play the opponent's best reply, as stored in the transposition table, on a board, returns
+        //false if there isn't one or the game would be over
+        bool expect_reply(Board &ref);
 
-        //make a string key for a given Board
-        string* make_key(Board &ref, char turn);
+        //end pondering on a miss, waiting for the search to stop
+        void stop_pondering();
 
-        //order moves to be checked for optimal pruning, for black
-        void b_order(char moves_c[], int moves_r[], int depth, int count);
+        //checks whether a move is late and quiet enough to search at reduced depth
+        bool reducible(Node *start, char c1, int r1, char c2, int r2, int make, int depth);
 
-        //order moves to be checked for optimal pruning, for white
-        void w_order(char moves_c[], int moves_r[], int depth, int count);
+        //checks whether the search has run out of time or been stopped
+        bool halted(int depth);
 
-        //update killer move arrays with moves that cause beta cutoffs
-        void update_killer(char c1, int r1, char c2, int r2, int depth);
+        //move the hop on the last search's line to the front of the move arrays, if it's there
+        void pv_first(char moves_c[], int moves_r[], int count);
 
-        //function to free hash table from pointer, used by concurrent thread
-        void concurrent_table_free(unordered_map<string, Mem_node>* temp);
+        //start the last search's line at the position now being searched, or drop it
+        void rebase_seed();
 
-        int deepw(Node *start, int depth);
+        //make the line of the node being searched the given hop followed by its child's line
+        void update_pv(char c1, int r1, char c2, int r2);
 
-        int deepb(Node *start, int depth);
+        //keep the best root scores of a multi-PV search, returns alpha for the next root move
+        int root_window(int top[], int &kept, int score);
 
-        void iterative_deepening(bool sub);
+        //put the best root moves of a multi-PV search in order, with their lines
+        void rank_lines(Node *start, int count, int choice);
 
-        void manage_memory();
+        //search a node with a color to move, scores being for black either way
+        template <char TURN>
+        int deep(Node *start, int depth);
 
-        void clear_history();
+        void iterative_deepening();
 
-        void pre_move(bool sub, bool go);
+        //search for the move to make, without the ponder hit and book checks of move
+        void search(bool go);
 
-        void evaluate_move_b(Node *start, char c1, int r1, char c2, int r2, int make, int depth);
+        void pre_move(bool go);
 
-        void evaluate_move_w(Node *start, char c1, int r1, char c2, int r2, int make, int depth);
+        //score the child made by a color's move
+        template <char TURN>
+        void evaluate_move(Node *start, char c1, int r1, char c2, int r2, int make, int depth);
 
-        void choose_move(Node *start, int count, int make, bool sub);
+        void choose_move(Node *start, int count);
 
     public:
         //constructor
@@ -190,27 +242,52 @@ class AI {
         //set difficulty
         void set_difficulty(int level);
 
+        //turn the opening book on or off
+        void use_book(bool on);
+
+        //set the transposition table size in megabytes, emptying it
+        void set_hash(int mb);
+
+        //empty the transposition table
+        void clear_hash();
+
+        //turn pondering on or off
+        void use_ponder(bool on);
+
+        //start searching the opponent's expected reply in the background, until the next update
+        void ponder();
+
         //updates the board held by the AI to the game board
         void update_AI(const Board ref);
 
-        //AI makes its decision about where to move
-        void move(bool sub, bool go);
+        //set the hashes of the game's positions that could still be repeated, ending with the current one
+        void set_history(const vector<uint64_t> &keys);
 
-        //makes additional jumps on a turn
-        bool multi(bool go);
+        //set the depth, time in milliseconds and positions to search, 0 for no limit, in place of a
+        //difficulty level
+        void set_limits(int depth, long long time, long long positions);
 
-        //functions to get notation of decided move
-        //get row of first square
-        char get_row1();
+        //set the number of root moves to find exact scores and lines for, 1 for just the best
+        void set_multi_pv(int lines);
 
-        //get column of first square
-        int get_col1();
+        //set a function to be called with the progress of the search after each depth
+        void set_reporter(function<void(const Search_info&)> report);
 
-        //get row of second square
-        char get_row2();
+        //end the current search as soon as possible, safe to call from another thread
+        void stop();
 
-        //get column of second square
-        int get_col2();
+        //get the deepest search completed on the last move, 0 if it was stopped before any
+        int get_depth() {
+            return completed;
+        }
 
+        //get the depth, score for black, positions searched and expected line of the last search
+        Search_info get_info();
+
+        //AI makes its decision about where to move
+        void move(bool go);
+
+        //makes additional jumps on a turn
+        bool multi(bool go);
 };
 #endif
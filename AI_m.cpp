@@ -0,0 +1,409 @@
+/*.cpp file for the AI_m class, Monty, the Monte Carlo tree search opponent. Each playout goes down the
+tree from the root, at each node taking the child with the best UCT score, its share of wins plus a
+bonus for having been tried less than its siblings, until it reaches a node with no children yet. That
+node's children are made, and the line is played on from it, at random, the result counting back up
+every node it went through. Over many playouts the tree grows down the lines each side does best on.
+
+Has 5 difficulty levels. The first 3 run 1,000, 5,000 and 20,000 playouts a move on one thread, so they
+play the same from the same seed. Levels 4 and 5 run as many as fit in 2 and 30 seconds, on a thread
+for each core.
+
+Random playouts to the end of a checkers game say little, so by default Monty is guided by Hayden's
+evaluation: a new node starts with the chance of winning its evaluation gives, counted as a few visits,
+and playouts go on for only a few turns before the position they reach is evaluated the same way.
+
+Threads share the tree without locks. Node counts are atomic, a node's children are made by the one
+thread that claims it, the others playing on from it meanwhile, and a thread going down a line counts
+it as a few losses until its result comes back, so the others spread out rather than all following
+the same line.*/
+
+#include <iostream>
+#include <cstdlib>
+#include <string>
+#include <cmath>
+#include <random>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "board.h"
+#include "tablebase.h"
+#include "eval.h"
+#include "engine.h"
+#include "AI_m.h"
+
+using namespace std;
+
+//constructor
+//parameters: NA
+//returns: NA
+AI_m::AI_m() : Engine(new Hayden_eval) {
+    name = "Monty";
+
+    set_difficulty(4);
+    guided = true;
+    start_ms = 0;
+    used = 0, full = false, playouts = 0;
+
+    rng.seed(time(NULL) + 2); //varied play by default, set_seed makes it repeatable
+
+    pool = new Tree_node[POOL_SIZE];
+}
+
+//destructor
+//parameters: NA
+//returns: NA
+AI_m::~AI_m() {
+    delete [] pool;
+}
+
+//intro, prints an intro message
+//parameters: NA
+//returns: void
+void AI_m::intro() {
+    cout << "Hello, I am " << name << ", your AI opponent\n";
+}
+
+//set_difficulty, sets the playouts Monty runs each turn, 1,000 for level 1, 5,000 for level 2 and 20,000
+//for level 3, on one thread, or for levels 4 and 5, as many as he can in 2 or 30 seconds on every core
+//parameters: an int for the difficulty level
+//returns: void
+void AI_m::set_difficulty(int level) {
+    int cores = thread::hardware_concurrency();
+
+    if (level == 1) {
+        set_limits(1000, 0, 1);
+    } else if (level == 2) {
+        set_limits(5000, 0, 1);
+    } else if (level == 3) {
+        set_limits(20000, 0, 1);
+    } else if (level == 4) {
+        set_limits(0, 2000, cores);
+    } else {
+        set_limits(0, 30000, cores);
+    }
+}
+
+//set_limits, sets the search directly, rather than by difficulty level
+//parameters: a long long for the playouts for each decision and one for the time in milliseconds, 0 for
+//no limit, and an int for the number of threads
+//returns: void
+void AI_m::set_limits(long long count, long long time, int workers) {
+    playout_limit = (count > 0) ? count : 0;
+    time_limit = (time > 0) ? time : 0;
+    threads = (workers < 1) ? 1 : ((workers > MAX_THREADS) ? MAX_THREADS : workers);
+
+    if ((playout_limit == 0) && (time_limit == 0))
+        playout_limit = 1000; //nothing would end the search otherwise
+}
+
+//use_guide, sets whether Monty is guided by his evaluation, with new nodes starting from it and short
+//playouts, or plays every playout out to the end at random
+//parameters: a bool for whether to be guided
+//returns: void
+void AI_m::use_guide(bool guide) {
+    guided = guide;
+}
+
+//move, AI makes its decision about where to move
+//parameters: NA
+//returns: void
+void AI_m::move() {
+    search(false);
+    state->make_move(col1, row1, col2, row2);
+}
+
+//multi, similar to move, but used when a piece has taken and may do so again, searching again from
+//just the jumping piece
+//parameters: NA
+//returns: a bool for whether or not futher jump can be made after the selected move
+bool AI_m::multi() {
+    search(true);
+    state->make_move(col1, row1, col2, row2);
+
+    return ((state->jump_possible(col2, row2, 'W')) && (!state->kinged()));
+}
+
+//search, grows a new tree from the held position, with the playouts split among the threads, and
+//chooses the root move played out most often, the one with the most wins between equals. With only
+//one move there's nothing to search.
+//parameters: a bool for whether a jump is going on, so only the piece that made it can move
+//returns: void
+void AI_m::search(bool again) {
+    Tree_node *root = &pool[0];
+    reset(root, 'I', DIMEN, 'I', DIMEN, 'W');
+    if (again)
+        root->jump_col = col2, root->jump_row = row2;
+
+    used = 1, full = false, playouts = 0;
+    start_ms = clock_ms();
+
+    Board scratch(*state);
+    expand<'W'>(root, *state, scratch);
+
+    if (root->count > 1) {
+        vector<thread> crew;
+        for (int i = 1; i < threads; i++)
+            crew.push_back(thread(&AI_m::work, this, rng()));
+
+        work(rng());
+        for (size_t i = 0; i < crew.size(); i++)
+            crew[i].join();
+    }
+
+    Tree_node *best = &pool[root->first];
+    for (int i = 1; i < root->count; i++) {
+        Tree_node *child = &pool[root->first + i];
+        if ((child->visits > best->visits) || ((child->visits == best->visits) &&
+        (child->wins > best->wins)))
+            best = child;
+    }
+
+    //set decided move accessible by getter
+    row1 = best->row1, row2 = best->row2;
+    col1 = best->col1, col2 = best->col2;
+}
+
+//work, runs playouts until the search is over, each thread with its own boards and random numbers
+//parameters: a seed for the thread's random number generator
+//returns: void
+void AI_m::work(uint64_t seed) {
+    mt19937_64 gen(seed);
+    Board walk(*state), scratch(*state);
+
+    while (!finished()) {
+        playout(walk, scratch, gen);
+        playouts++;
+    }
+}
+
+//playout, goes down the tree by UCT score to a node without children, makes them, and plays on from
+//there, then adds the result to every node on the way, for the color that moved to it. Each node is
+//counted as lost VIRTUAL_LOSS times on the way down, and the losses taken back with the result.
+//parameters: refs to a Board to play the line on and one to make children on, and to the thread's
+//random number generator
+//returns: void
+void AI_m::playout(Board &walk, Board &scratch, mt19937_64 &gen) {
+    Tree_node *line_nodes[MAX_LINE];
+    int length = 0, result;
+    Tree_node *node = &pool[0];
+    walk = *state;
+
+    while (true) {
+        node->visits.fetch_add(VIRTUAL_LOSS, memory_order_relaxed);
+        line_nodes[length] = node;
+        length++;
+
+        int now = node->state.load(memory_order_acquire);
+        if ((now == GROWN) && (length < MAX_LINE)) {
+            Tree_node *next = choose(node);
+            if (node->turn == 'B') {
+                play<'B'>(walk, next);
+            } else {
+                play<'W'>(walk, next);
+            }
+
+            node = next;
+            continue;
+        }
+
+        //claim the node to make its children, unless another thread has
+        int open = OPEN;
+        if ((now == OPEN) && (node->state.compare_exchange_strong(open, GROWING))) {
+            if (node->turn == 'B') {
+                expand<'B'>(node, walk, scratch);
+            } else {
+                expand<'W'>(node, walk, scratch);
+            }
+
+            now = node->state.load(memory_order_acquire);
+        }
+
+        if (now == OVER) {
+            result = (node->turn == 'W') ? 0 : WIN; //the side to move has lost
+        } else {
+            int left = guided ? GUIDED_ROLLOUT : MAX_ROLLOUT;
+            if (node->turn == 'B') {
+                result = roll<'B'>(walk, node->jump_col, node->jump_row, left, gen);
+            } else {
+                result = roll<'W'>(walk, node->jump_col, node->jump_row, left, gen);
+            }
+        }
+
+        break;
+    }
+
+    for (int i = 0; i < length; i++) {
+        char mover = (i > 0) ? line_nodes[i - 1]->turn : 'B';
+        line_nodes[i]->wins.fetch_add((mover == 'W') ? result : WIN - result, memory_order_relaxed);
+        line_nodes[i]->visits.fetch_add(1 - VIRTUAL_LOSS, memory_order_relaxed);
+    }
+}
+
+//choose, finds the child of a node with the best UCT score, its share of wins for the color to move
+//plus a bonus that grows the less it's been tried next to its parent, trying any child not yet tried
+//first
+//parameters: a pointer to the node, which has its children
+//returns: a pointer to the chosen child
+AI_m::Tree_node *AI_m::choose(Tree_node *node) {
+    Tree_node *children = &pool[node->first];
+    int total = node->visits.load(memory_order_relaxed);
+    double spread = log((double) ((total > 1) ? total : 1));
+    double best_score = -1;
+    int best = 0;
+
+    for (int i = 0; i < node->count; i++) {
+        int visits = children[i].visits.load(memory_order_relaxed);
+        if (visits == 0)
+            return &children[i];
+
+        double score = (children[i].wins.load(memory_order_relaxed) / (double) (visits * WIN)) +
+        ((EXPLORE / 100.0) * sqrt(spread / visits));
+        if (score > best_score) {
+            best_score = score;
+            best = i;
+        }
+    }
+
+    return &children[best];
+}
+
+//expand, makes the children of a node for the color to move from it, given as the template parameter,
+//from the pool, or marks it over if there are none. When guided, each child starts with the chance its
+//evaluation gives the color moving to it, as PRIOR_VISITS visits. The node is only marked grown once
+//its children are all set, so other threads never go down to one half made.
+//parameters: a pointer to the node, a ref to the Board with its position and one to make the children on
+//returns: a bool for whether the children were made, false if the pool ran out
+template <char TURN>
+bool AI_m::expand(Tree_node *node, Board &walk, Board &scratch) {
+    const char OTHER = (TURN == 'W') ? 'B' : 'W';
+    int count = 0; //number of possible moves
+    char c1, c2, c3, c4; //position variables
+    int r1, r2, r3, r4;
+    int moves_r[96]; //arrays with square locations for possible moves
+    char moves_c[96];
+
+    if (node->jump_col != 0) {
+        jumps_from<TURN>(walk, node->jump_col, node->jump_row, moves_c, moves_r, count);
+    } else {
+        generate<TURN>(walk, moves_c, moves_r, count);
+    }
+
+    if (count == 0) {
+        node->count = 0;
+        node->state.store(OVER, memory_order_release);
+        return true;
+    }
+
+    int first = used.fetch_add(count);
+    if (first + count > POOL_SIZE) {
+        full = true;
+        node->state.store(OPEN, memory_order_release);
+        return false;
+    }
+
+    for (int make = 0; make < count; make++) {
+        Tree_node *child = &pool[first + make];
+        scratch = walk;
+        make_turn<TURN>(scratch, moves_c, moves_r, make, c1, c2, c3, c4, r1, r2, r3, r4);
+
+        //a jump that can go on in more than one way leaves the same color to move
+        if ((abs(r2 - r1) == 2) && (scratch.num_jumps(c4, r4) > 1) && (!scratch.kinged())) {
+            reset(child, c1, r1, c2, r2, TURN);
+            child->jump_col = c4, child->jump_row = r4;
+        } else {
+            reset(child, c1, r1, c2, r2, OTHER);
+        }
+
+        if (guided) {
+            int odds = chance(eval->calc(scratch));
+            child->visits.store(PRIOR_VISITS, memory_order_relaxed);
+            child->wins.store(PRIOR_VISITS * ((TURN == 'W') ? odds : WIN - odds), memory_order_relaxed);
+        }
+    }
+
+    node->first = first, node->count = count;
+    node->state.store(GROWN, memory_order_release);
+    return true;
+}
+
+//play, makes the move to a node on a board for the color given as the template parameter, along with
+//any further jumps it's forced to make, which are the same ones made when the node was
+//parameters: a ref to the Board, a pointer to the node
+//returns: void
+template <char TURN>
+void AI_m::play(Board &walk, Tree_node *node) {
+    char c1, c2, c3, c4; //position variables
+    int r1, r2, r3, r4;
+    char moves_c[2] = {node->col1, node->col2};
+    int moves_r[2] = {node->row1, node->row2};
+
+    make_turn<TURN>(walk, moves_c, moves_r, 0, c1, c2, c3, c4, r1, r2, r3, r4);
+}
+
+//roll, plays on from a position with random moves for the color given as the template parameter and
+//then the other, for a number of turns, after which the position is evaluated. A jump that can go on in
+//more than one way goes on within the same turn.
+//parameters: a ref to the Board, a char and an int for the square a jump goes on from, a char of 0 if
+//none does, an int for the turns left, and a ref to the thread's random number generator
+//returns: an int for the result for white, in thousandths of a win
+template <char TURN>
+int AI_m::roll(Board &walk, char c1, int r1, int left, mt19937_64 &gen) {
+    const char OTHER = (TURN == 'W') ? 'B' : 'W';
+    int count = 0; //number of possible moves
+    char c2, c3, c4; //position variables
+    int r2, r3, r4;
+    int moves_r[96]; //arrays with square locations for possible moves
+    char moves_c[96];
+
+    if (left == 0)
+        return chance(eval->calc(walk));
+
+    if (c1 != 0) {
+        jumps_from<TURN>(walk, c1, r1, moves_c, moves_r, count);
+    } else {
+        generate<TURN>(walk, moves_c, moves_r, count);
+    }
+
+    if (count == 0)
+        return (TURN == 'W') ? 0 : WIN; //the side to move has lost
+
+    make_turn<TURN>(walk, moves_c, moves_r, gen() % count, c1, c2, c3, c4, r1, r2, r3, r4);
+    if ((abs(r2 - r1) == 2) && (walk.num_jumps(c4, r4) > 1) && (!walk.kinged()))
+        return roll<TURN>(walk, c4, r4, left, gen);
+
+    return roll<OTHER>(walk, 0, 0, left - 1, gen);
+}
+
+//chance, converts an evaluation for white to a chance of white winning, by the logistic curve, so
+//EVAL_SCALE is worth about three wins in four
+//parameters: an int for the evaluation
+//returns: an int for the chance, in thousandths
+int AI_m::chance(int score) {
+    return (int) (WIN / (1 + exp(-score / (double) EVAL_SCALE)));
+}
+
+//reset, sets up a node taken from the pool as new, without children or results
+//parameters: a pointer to the node, chars and ints for the move to it, a char for the color to move
+//returns: void
+void AI_m::reset(Tree_node *node, char c1, int r1, char c2, int r2, char turn) {
+    node->visits.store(0, memory_order_relaxed);
+    node->wins.store(0, memory_order_relaxed);
+    node->state.store(OPEN, memory_order_relaxed);
+    node->first = 0, node->count = 0;
+    node->col1 = c1, node->row1 = r1, node->col2 = c2, node->row2 = r2;
+    node->turn = turn;
+    node->jump_col = 0, node->jump_row = 0;
+}
+
+//finished, checks whether the search has run its playouts or its time, or the pool has run out
+//parameters: NA
+//returns: a bool for whether to stop
+bool AI_m::finished() {
+    if (full)
+        return true;
+
+    if ((playout_limit > 0) && (playouts >= playout_limit))
+        return true;
+
+    return (time_limit > 0) && (clock_ms() - start_ms >= time_limit);
+}
@@ -0,0 +1,167 @@
+/*AI_m.h, the header file for the AI_m class, a third opponent for Thomas in mode 4, which plays white
+like Hayden but decides by Monte Carlo tree search rather than minimax. Rather than searching every
+move to a depth, it plays out lines from the position again and again, growing a tree of the moves it's
+tried, and goes down the ones that have done best most often, so it spends its time on the lines that
+matter. The move played most often at the root is the one made.
+
+Several threads can grow the same tree at once, which suits machines with many cores better than a
+minimax search does. Tree nodes come from a pool taken from with an atomic counter, so no locks are
+needed, and a thread going down a line counts it as lost until it's played out, so the others spread
+to other lines meanwhile.
+
+One of three AI objects, this one seen as "Monty."*/
+
+#include <iostream>
+#include <cstdlib>
+#include <string>
+#include <random>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "board.h"
+#include "tablebase.h"
+#include "eval.h"
+#include "engine.h"
+
+using namespace std;
+
+#ifndef AI_M_H
+#define AI_M_H
+
+class AI_m : public Engine {
+    private:
+        //node of the search tree. Its move, the first hop of a turn, leads to it from its parent, with
+        //any single further jumps made along with it. A turn whose jump can go on in more than one way
+        //stops at a node with the same color to move, which may only go on from the jumping piece.
+        struct Tree_node {
+            //times the node has been gone through, counting the playouts under way as losses, and
+            //the results for the color that moved to it, in thousandths of a win
+            atomic<int> visits;
+            atomic<long long> wins;
+
+            //whether its children have been made, are being made, or it's been found over
+            atomic<int> state;
+
+            //place of its first child in the pool, and how many there are
+            int first, count;
+
+            //move to it, the color to move from it, and the square a jump goes on from, if one does
+            char col1, col2, row1, row2;
+            char turn;
+            char jump_col, jump_row;
+        };
+
+        //playouts, and the time in milliseconds, for each decision, 0 for no limit, and the threads
+        //they're split among
+        long long playout_limit, time_limit;
+        int threads;
+
+        //whether the results of new nodes start from their evaluation, with short playouts evaluated
+        //where they end, rather than played to the end at random
+        bool guided;
+
+        //pool the tree's nodes come from, how many have been taken on the search under way, and
+        //whether it ran out
+        Tree_node *pool;
+        atomic<int> used;
+        atomic<bool> full;
+
+        //playouts finished on the search under way, and when it started
+        atomic<long long> playouts;
+        long long start_ms;
+
+        //states of a node
+        const static int OPEN = 0, GROWING = 1, GROWN = 2, OVER = 3;
+
+        //nodes in the pool
+        const static int POOL_SIZE = 1 << 21;
+
+        //most threads searched with
+        const static int MAX_THREADS = 64;
+
+        //longest line gone down the tree, and the turns in a playout, guided or not, past which the
+        //position it reaches is evaluated
+        const static int MAX_LINE = 256, GUIDED_ROLLOUT = 4, MAX_ROLLOUT = 200;
+
+        //visits a playout under way counts for, all lost, until its result comes back
+        const static int VIRTUAL_LOSS = 3;
+
+        //visits the evaluation of a new node counts for, when guided
+        const static int PRIOR_VISITS = 10;
+
+        //a whole win, in the units results are kept in
+        const static int WIN = 1000;
+
+        //exploration constant of the UCT formula, in hundredths
+        const static int EXPLORE = 100;
+
+        //evaluation that counts as a win three times out of four, about a piece
+        const static int EVAL_SCALE = 200;
+
+        //runs playouts from the held position until the search is over, one thread's share
+        void work(uint64_t seed);
+
+        //plays out one line, down the tree and then on at random, and counts its result back up the tree
+        void playout(Board &walk, Board &scratch, mt19937_64 &gen);
+
+        //chooses the child of a node with the best UCT score
+        Tree_node *choose(Tree_node *node);
+
+        //makes the children of a node, with the position it's at, returns false if the pool ran out
+        template <char TURN>
+        bool expand(Tree_node *node, Board &walk, Board &scratch);
+
+        //makes a node's move on a board, along with the jumps forced after it
+        template <char TURN>
+        void play(Board &walk, Tree_node *node);
+
+        //plays on at random from a position for a number of turns, from only the jumping piece if a
+        //jump goes on, returns the result for white
+        template <char TURN>
+        int roll(Board &walk, char c1, int r1, int left, mt19937_64 &gen);
+
+        //converts an evaluation for white to a chance of white winning, in thousandths
+        int chance(int score);
+
+        //sets a node up as new, with a move to it and the color to move from it
+        void reset(Tree_node *node, char c1, int r1, char c2, int r2, char turn);
+
+        //checks whether the search has used up its playouts or time, or the pool
+        bool finished();
+
+        //searches the held position, from only the jumping piece when a jump goes on, and sets the
+        //move chosen
+        void search(bool again);
+
+    public:
+        //constructor
+        AI_m();
+
+        //destructor
+        ~AI_m();
+
+        //intro message
+        void intro();
+
+        //set difficulty
+        void set_difficulty(int level);
+
+        //set the playouts, time and threads directly, rather than by difficulty level
+        void set_limits(long long count, long long time, int workers);
+
+        //set whether new nodes start from their evaluation and playouts are short, or are played out
+        //to the end at random
+        void use_guide(bool guide);
+
+        //AI makes its decision about where to move
+        void move();
+
+        //makes additional jumps on a turn
+        bool multi();
+
+        //get the playouts run by the last search
+        long long get_playouts() {
+            return playouts;
+        }
+};
+#endif
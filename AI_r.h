@@ -1,143 +1,110 @@
 /*AI_r.h, the header file for the AI_r class, which plays against another AI in mode 3. Utilizes a 
-minimax evaluation tree to make decisions, which are then accessed by the main through getters for 
-the move notation.
+minimax evaluation tree, searched to a set depth or by iterative deepening against the clock, to make 
+decisions, which are then accessed by the main through getters for the move notation.
 
 One of two AI objects, this one seen as "Hayden."*/
 
 #include <iostream>
 #include <cstdlib>
 #include <string>
+#include <random>
+#include <vector>
+#include <chrono>
 #include "board.h"
+#include "tablebase.h"
+#include "eval.h"
+#include "engine.h"
+#include "table.h"
+#include "order.h"
 
 using namespace std;
 
 #ifndef AI_R_H
 #define AI_R_H
 
-class AI_r {
+class AI_r : public Engine {
     private:
-        //board held by AI to make decisions
-        Board *state;
+        //search limits, the depth in plies, 0 to deepen until time runs out, and the time for each 
+        //decision in milliseconds, 0 for none
+        int depth_limit;
+        long long time_limit;
 
-        //name of AI
-        string name;
+        //whether the depth is set by how many positions the next one is expected to take, and extended
+        //by two for a simple endgame
+        bool adapt, extend;
 
-        //variable for difficulty level
-        int difficulty;
+        //depth always searched in full, the search only being stopped on deeper ones
+        int least;
 
-        //position variables for chosen move
-        char col1, col2;
-        int row1, row2;
+        //positions searched so far on this decision, and on the depth finished last
+        long long nodes, last_nodes;
 
-        //restrictions on possible moves for evaluating multiple jumps
-        bool diverge, repeat;
+        //effective branching factor, how many times more positions each depth takes than the one before,
+        //measured as the search deepens and carried from move to move
+        double branching;
 
-        //hold piece position for divergent multiple jumps
-        char d_col;
-        int d_row;
+        //ply at which positions are scored in the search under way, before any endgame extension
+        int horizon;
 
-        //variables for alpha-beta pruning
-        int level1_max, level2_min, level3_max, level4_min, level5_max, level6_min, level7_max,
-        level8_min, level9_max, level10_min;
+        //when the search started, and whether it ran out of time
+        long long start_ms;
+        bool stopped;
 
-        //rough measure of tree complexity at each move
-        int complexity;
+        //best score found so far at each ply of the current line, for alpha-beta pruning, the max at 
+        //Hayden's plies and the min at the opponent's
+        int bound[64];
 
-        //board size constant
-        const static int DIMEN = 8;
+        //transposition table, kept from move to move
+        Table<Mem_node> *memory;
 
-        //piece constants
-        const static char WHITE_PIECE = 'r', WHITE_KING = 'R';
-        const static char BLACK_PIECE = 'b', BLACK_KING = 'B';
-        const static char BLANK = ' ', BLACK_SQUARE = '-';
+        //killer moves and history scores for ordering moves
+        Move_order ordering;
 
-        struct Node {
-            Board *position;
-            int score;
-            Node *options;
-            char row1, row2;
-            int col1, col2;
-        };
-        
-        //evaluates how favorable a position is to the AI
-        int calc(Board &ref);
+        //deepest search, with room for an endgame extension
+        const static int MAX_PLY = 64;
 
-        //calculates the distance of a piece from the nearest opposing piece
-        short proximity(int row, int column, char turn, Board &ref, int num_b, int num_w);
+        //depth always searched in full on a timed search
+        const static int MIN_DEPTH = 3;
 
-        //finds the average distance between the kings of a given color and the nearest opposing piece
-        double closeness(Board &ref, char color);
+        //shallowest and deepest searches when the depth is set by the number of positions, and the number
+        //a decision is meant to take, of which it can take twice as many before the depth is given up
+        const static int ADAPT_FLOOR = 7, ADAPT_CEILING = 11;
+        const static long long ADAPT_NODES = 50000;
 
-        //fill the move option arrays for the max node deep functions
-        void fill_b(Node *start, char moves_c[], int moves_r[], int &count);
+        //branching factor assumed before any has been measured, and the most a single measurement
+        //counts for, from a depth of at least MEASURE_NODES positions
+        const static int START_BRANCHING = 3, MAX_BRANCHING = 8, MEASURE_NODES = 100;
 
-        //fill the move option arrays from only one starting square
-        void fill_multi(char moves_c[], int moves_r[], int &count, char c1, int r1, char color);
+        //transposition table size in megabytes
+        const static int HASH_MB = 64;
 
-        //fill the move option arrays for the min node deep functions
-        void fill_w(Node *start, char moves_c[], int moves_r[], int &count);
+        //kinds of stored score, exact, at least the score, or at most the score
+        const static char EXACT = 0, LOWER = 1, UPPER = 2;
 
-        //fill the move options arrays for the max node deep functions for diverging jumps
-        void diverge_b(Node *start, char moves_c[], int moves_r[], int &count);
+        //scores beyond this are wins found by the search, counted by ply
+        const static int WIN_FOUND = 9900;
 
-        //fill the move options arrays for the min node deep functions for diverging jumps
-        void diverge_w(Node *start, char moves_c[], int moves_r[], int &count);
+        //evaluates the moves at a node for the color to move, recursing to the horizon
+        template <char TURN>
+        int deep(Board &ref, int ply, int limit);
 
-        //make the moves on the board from the move arrays for the max nodes
-        void moving_b(Node *start, char moves_c[], int moves_r[], int &make, char &c1, char &c2, 
-        char &c3, char &c4, int &r1, int &r2, int &r3, int &r4);
+        //convert a score to and from the transposition table, where wins are counted from the position
+        int to_table(int score, int ply);
+        int from_table(int score, int ply);
 
-        //make the moves on the board from the move arrays for the min nodes
-        void moving_w(Node *start, char moves_c[], int moves_r[], int &make, char &c1, char &c2, 
-        char &c3, char &c4, int &r1, int &r2, int &r3, int &r4);
+        //finds the move to make, deepening the search for as long as there's time on a timed one
+        void search(bool again);
 
-        //return the max value at the node, clean up arrays
-        int maximize(Node *start, char moves_c[], int moves_r[], int &make);
+        //searches every move at the root to a given depth, from only the jumping piece when a jump 
+        //goes on, returns false if it ran out of time before finishing
+        bool search_root(int limit, bool again);
 
-        //return the min value at the node, clean up arrays
-        int minimize(Node *start, char moves_c[], int moves_r[], int &make);
+        //checks whether the search has run out of time or positions
+        bool halted();
 
-        //evaluates future possible moves, at 1st level down, called by move() for divergent multi jumps
-        int deep0(Node *start);
-        
-        //evaluates future possible moves, 2nd level down
-        int deep1(Node* start);
-
-        //evaluates future possible moves, 3rd level down
-        int deep2(Node *start);
-
-        //evaluates future possible moves, 4th level down
-        int deep3(Node *start);
-
-        //evaluates future possible moves, 5th level down
-        int deep4(Node *start);
-
-        //evaluates future possible moves, 6th level down
-        int deep5(Node *start);
-
-        //evaluates future possible moves, 7th level down
-        int deep6(Node *start);
-
-        //evaluates future possible moves, 8th level down
-        int deep7(Node *start);
-
-        //evaluates future possible moves, 9th level down
-        int deep8(Node *start);
-
-        //evaluates future possible moves, 10th level down
-        int deep9(Node *start);
-
-        //evaluates future possible moves, 11th level down
-        int deep10(Node *start);
-
-        //chooses a move after score evaluations have been made
-        void select(Node *start, int &count, int &make, char color);
-
-        //same as above, but choose a next best move to avoid repetition
-        void select_second(Node *start, int &count, int &make, char color);
-
-        //counter for the numbers of possibilities evaluated
-        long tree;
+        //measures the branching factor from the depth just finished, and checks whether the next one
+        //is expected to fit in what's left of the time or positions
+        bool deeper(long long searched, long long spent);
 
     public:
         //constructor
@@ -152,30 +119,14 @@ class AI_r {
         //set difficulty
         void set_difficulty(int level);
 
-        //updates the board held by the AI to the game board
-        void update_AI(const Board ref);
+        //set the depth and time directly, rather than by difficulty level
+        void set_limits(int depth, long long time);
 
         //AI makes its decision about where to move
-        void move(bool sub);
-
-        //functions to get notation of decided move
-        //get row of first square
-        char get_row1();
-
-        //get column of first square
-        int get_col1();
-
-        //get row of second square
-        char get_row2();
-
-        //get column of second square
-        int get_col2();
+        void move();
 
         //makes additional jumps on a turn
         bool multi();
 
-        //roughly find complexity of position by multiplying number of possible moves for each side
-        int find_complexity();
-
 };
 #endif
@@ -0,0 +1,57 @@
+/*.cpp file for the Arena class, the bump allocator the AIs make their search trees from. Taking memory
+is moving a count along a block, and giving it back is moving the count back.*/
+
+#include <new>
+#include <vector>
+#include <cstddef>
+#include "arena.h"
+
+using namespace std;
+
+const size_t Arena::BLOCK_BYTES, Arena::ALIGN;
+
+//constructor, starts with one block
+//parameters: NA
+//returns: NA
+Arena::Arena() {
+    blocks.push_back(new char[BLOCK_BYTES]);
+    sizes.push_back(BLOCK_BYTES);
+    current = 0, used = 0;
+}
+
+//destructor
+//parameters: NA
+//returns: NA
+Arena::~Arena() {
+    for (size_t i = 0; i < blocks.size(); i++)
+        delete [] blocks[i];
+}
+
+//reset, gives back everything taken from the arena at once, going back to the start of the first block
+//parameters: NA
+//returns: void
+void Arena::reset() {
+    current = 0, used = 0;
+}
+
+//take, takes a number of bytes from the block being taken from, rounded up to keep the next ones
+//aligned. What doesn't fit goes in the next block big enough, which is added if there isn't one, the
+//rest of the block being left unused until the arena goes back past it.
+//parameters: a size_t for the number of bytes
+//returns: a pointer to the memory taken
+char* Arena::take(size_t bytes) {
+    bytes = (bytes + ALIGN - 1) & ~(ALIGN - 1);
+
+    while (used + bytes > sizes[current]) {
+        current++, used = 0;
+        if (current == (int) blocks.size()) {
+            size_t size = (bytes > BLOCK_BYTES) ? bytes : BLOCK_BYTES;
+            blocks.push_back(new char[size]);
+            sizes.push_back(size);
+        }
+    }
+
+    char *place = blocks[current] + used;
+    used += bytes;
+    return place;
+}
@@ -0,0 +1,78 @@
+/*arena.h, the header file for the Arena class, the memory a search's tree is made from. Everything a
+search makes, its Nodes, Boards and move arrays, is taken from the end of a block of memory, one after
+the other, and none of it is given back on its own: the whole arena is reset once at the start of each
+decision, and a search can go back to a mark, giving back everything taken since at once, as each
+position's subtree is finished with.
+
+Blocks are kept from reset to reset, so once the first few decisions have grown the arena to what a
+search needs, searching takes nothing more from the allocator. Only what can be thrown away without
+running its destructor can be made in the arena.*/
+
+#include <new>
+#include <vector>
+#include <cstddef>
+
+using namespace std;
+
+#ifndef ARENA_H
+#define ARENA_H
+
+class Arena {
+    private:
+        //blocks memory is taken from, their sizes, the one being taken from, and how far into it
+        vector<char*> blocks;
+        vector<size_t> sizes;
+        int current;
+        size_t used;
+
+        //bytes in a block, unless something bigger is taken
+        const static size_t BLOCK_BYTES = 1 << 20;
+
+        //alignment of everything taken, enough for any type
+        const static size_t ALIGN = 16;
+
+        //take a number of bytes, going on to the next block if they don't fit in this one
+        char* take(size_t bytes);
+
+    public:
+        //place in the arena, everything taken after which can be given back at once
+        struct Mark {
+            int block;
+            size_t used;
+        };
+
+        //constructor
+        Arena();
+
+        //destructor
+        ~Arena();
+
+        //give back everything taken, keeping the blocks
+        void reset();
+
+        //get the place in the arena
+        Mark mark() {
+            Mark here;
+            here.block = current, here.used = used;
+            return here;
+        }
+
+        //give back everything taken since a mark
+        void rewind(const Mark &here) {
+            current = here.block, used = here.used;
+        }
+
+        //take an array of a type, left as it comes
+        template <class T>
+        T* make(int count) {
+            return (T*) take(sizeof(T) * ((count > 0) ? count : 1));
+        }
+
+        //take a copy of an object
+        template <class T>
+        T* copy(const T &other) {
+            return new (take(sizeof(T))) T(other);
+        }
+};
+
+#endif
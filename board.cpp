@@ -21,13 +21,19 @@ colors, switching corresponding characters, and printing rows in horizontally re
 #include <cstdlib>
 #include <string>
 #include <cctype>
+#include <cstring>
 #include <cmath>
 #include <stdio.h>
 #include <stdlib.h>
+#include <random>
 #include "board.h"
 
 using namespace std;
 
+uint64_t Board::zobrist[32][4];
+uint64_t Board::kinged_key, Board::turn_key;
+bool Board::zobrist_ready = Board::fill_zobrist();
+
 //constructor
 //parameters: NA
 //returns: NA
@@ -41,7 +47,7 @@ Board::Board() {
     just_kinged = false;
 
     for (int i = 0; i < 34; i++)
-        key.push_back(' ');
+        key[i] = ' ';
 
     int place = 0;
     for (int i = 0; i < DIMEN; i++) {
@@ -57,6 +63,7 @@ Board::Board() {
     num_white = START_NUM;
 
     locate(); //find the information for the Place arrays
+    rehash();
 }
 
 //copy constructor
@@ -77,7 +84,7 @@ Board::Board(const Board &other) {
     just_kinged = other.just_kinged;
 
     for (int i = 0; i < 34; i++)
-        key.push_back(' ');
+        key[i] = ' ';
 
     int place = 0;
     for (int i = 0; i < DIMEN; i++) {
@@ -91,6 +98,7 @@ Board::Board(const Board &other) {
 
     num_black = other.num_black;
     num_white = other.num_white;
+    hash = other.hash;
 
     locate();
 }
@@ -145,79 +153,268 @@ void Board::reverse() {
     }
 
     locate();  //find the information for the Place arrays
+    rehash();
+}
+
+//setup, puts the board in a given position, with squares numbered as in the hashing key,
+//(row * 8 + column) / 2, in either orientation
+//parameters: an array of 32 chars for the contents of the playable squares, a bool for the reversed
+//orientation
+//returns: void
+void Board::setup(const char squares[32], bool reversed) {
+    for (int i = 0; i < DIMEN; i++) {
+        for (int j = 0; j < DIMEN; j++) {
+            if ((((i + j) % 2) == 1) != reversed) {
+                game_board[i][j] = BLACK_SQUARE;
+            } else {
+                game_board[i][j] = BLANK;
+            }
+        }
+    }
+
+    for (int s = 0; s < 32; s++) {
+        int row = s / 4;
+        int col = (2 * (s % 4)) + ((((row % 2) == 0) != reversed) ? 1 : 0);
+        game_board[row][col] = squares[s];
+        key[s] = squares[s];
+    }
+
+    for (int i = 0; i < 4; i++)
+        last_move[i] = DIMEN;
+    just_kinged = false;
+
+    locate();
+    rehash();
+}
+
+//flip, turns the board around and swaps the colors of the pieces, so the position can be searched 
+//from the other side, square s becoming square 31 - s in either orientation
+//parameters: NA
+//returns: void
+void Board::flip() {
+    bool reversed = (game_board[0][0] != BLANK);
+    char squares[32];
+
+    for (int s = 0; s < 32; s++) {
+        int row = s / 4;
+        int col = (2 * (s % 4)) + ((((row % 2) == 0) != reversed) ? 1 : 0);
+        char piece = game_board[row][col];
+
+        if (piece == WHITE_PIECE) {
+            piece = BLACK_PIECE;
+        } else if (piece == WHITE_KING) {
+            piece = BLACK_KING;
+        } else if (piece == BLACK_PIECE) {
+            piece = WHITE_PIECE;
+        } else if (piece == BLACK_KING) {
+            piece = WHITE_KING;
+        }
+
+        squares[31 - s] = piece;
+    }
+
+    setup(squares, reversed);
+}
+
+//to_fen, writes the position in the FEN notation of PDN, the side to move, then the white and black 
+//pieces by standard square number, 1 to 32 from black's side, with kings marked K (i.e. 
+//B:W21,22,K32:B1,2,12). A reversed board is written as its standard mirror image.
+//parameters: a char for the color to move, a buffer to write into and its size, at least FEN_SIZE
+//returns: an int for the length written, not counting the terminating null, or -1 if it didn't fit
+int Board::to_fen(char turn, char buffer[], int size) {
+    bool reversed = (game_board[0][0] != BLANK);
+    int length = 0;
+
+    if (size < FEN_SIZE)
+        return -1;
+
+    buffer[length++] = (turn == 'W') ? 'W' : 'B';
+
+    for (int side = 0; side < 2; side++) {
+        char piece = (side == 0) ? WHITE_PIECE : BLACK_PIECE;
+        char king = (side == 0) ? WHITE_KING : BLACK_KING;
+        bool listed = false;
+
+        buffer[length++] = ':';
+        buffer[length++] = (side == 0) ? 'W' : 'B';
+
+        for (int s = 0; s < 32; s++) {
+            int row = s / 4;
+            int col = (2 * (s % 4)) + (((row % 2) == 0) ? 1 : 0);
+            if (reversed)
+                col = DIMEN_LESS1 - col;
+
+            if ((game_board[row][col] != piece) && (game_board[row][col] != king))
+                continue;
+
+            if (listed)
+                buffer[length++] = ',';
+            if (game_board[row][col] == king)
+                buffer[length++] = 'K';
+            if (s + 1 >= 10)
+                buffer[length++] = '0' + ((s + 1) / 10);
+            buffer[length++] = '0' + ((s + 1) % 10);
+            listed = true;
+        }
+    }
+
+    buffer[length] = '\0';
+    return length;
+}
+
+//from_fen, sets up the board from a FEN string in PDN notation, in the standard orientation. Accepts
+//a whole FEN tag, either color's pieces first, and ranges of squares (i.e. [FEN "W:B1-12:W21-32"]).
+//parameters: a null-terminated string holding the FEN, a char ref for the color to move
+//returns: a bool for whether the string was valid, the board is unchanged if not
+bool Board::from_fen(const char text[], char &turn) {
+    char squares[32];
+    int count[2] = {0, 0};
+    const char *at = text;
+
+    for (int s = 0; s < 32; s++)
+        squares[s] = BLACK_SQUARE;
+
+    //skip the tag around the string, if it's there
+    while ((*at == ' ') || (*at == '[') || (*at == '"'))
+        at++;
+    if (strncmp(at, "FEN", 3) == 0) {
+        at += 3;
+        while ((*at == ' ') || (*at == '"'))
+            at++;
+    }
+
+    char side = toupper(*at++);
+    if ((side != 'B') && (side != 'W'))
+        return false;
+
+    //each section is a color and a list of squares
+    while (*at == ':') {
+        at++;
+        char color = toupper(*at++);
+        if ((color != 'B') && (color != 'W'))
+            return false;
+
+        while ((*at != ':') && (*at != '\0') && (*at != '"') && (*at != '.') && (*at != ' ')) {
+            bool king = false;
+            if (toupper(*at) == 'K')
+                king = true, at++;
+
+            int first = 0, last;
+            if (!isdigit(*at))
+                return false;
+            while (isdigit(*at))
+                first = (first * 10) + (*at++ - '0');
+
+            last = first;
+            if (*at == '-') {
+                at++;
+                if (!isdigit(*at))
+                    return false;
+                last = 0;
+                while (isdigit(*at))
+                    last = (last * 10) + (*at++ - '0');
+            }
+
+            if ((first < 1) || (last > 32) || (first > last))
+                return false;
+
+            for (int n = first; n <= last; n++) {
+                //each color has room for START_NUM pieces in its location array
+                if ((squares[n - 1] != BLACK_SQUARE) || (++count[color == 'W'] > START_NUM))
+                    return false;
+
+                if (color == 'W') {
+                    squares[n - 1] = king ? WHITE_KING : WHITE_PIECE;
+                } else {
+                    squares[n - 1] = king ? BLACK_KING : BLACK_PIECE;
+                }
+            }
+
+            if (*at == ',')
+                at++;
+        }
+    }
+
+    while ((*at == ' ') || (*at == '"') || (*at == '.') || (*at == ']'))
+        at++;
+    if (*at != '\0')
+        return false;
+
+    setup(squares, false);
+    turn = side;
+
+    return true;
 }
 
 //rando, plays three random moves to start the game, producing a wider number of possible games 
 //in AI vs AI mode
-//parameters: an integer to add to the unix time seed, to increase randomness when multiple games
-//occur within a second
+//parameters: a seed for the opening's random number generator
 //returns: NA
-void Board::rando(int seed) {
+void Board::rando(uint64_t seed) {
     char c1, c2;
     int r1, r2;
-    srand(time(NULL) + seed);
+    mt19937_64 rng(seed); //own generator, so the same seed always gives the same opening
 
     //first move
     do {
-        c1 = (rand() % DIMEN) + 'A';
-        r1 = rand() % DIMEN;
-        c2 = (rand() % DIMEN) + 'A';
-        r2 = rand() % DIMEN;
+        c1 = (rng() % DIMEN) + 'A';
+        r1 = rng() % DIMEN;
+        c2 = (rng() % DIMEN) + 'A';
+        r2 = rng() % DIMEN;
     } while (!check_validity(c1, r1, c2, r2, 'W'));
     make_move(c1, r1, c2, r2);
 
     //second move
     do {
-        c1 = (rand() % DIMEN) + 'A';
-        r1 = rand() % DIMEN;
-        c2 = (rand() % DIMEN) + 'A';
-        r2 = rand() % DIMEN;
+        c1 = (rng() % DIMEN) + 'A';
+        r1 = rng() % DIMEN;
+        c2 = (rng() % DIMEN) + 'A';
+        r2 = rng() % DIMEN;
     } while (!check_validity(c1, r1, c2, r2, 'B'));
     make_move(c1, r1, c2, r2);
 
     //third move
     do {
-        c1 = (rand() % DIMEN) + 'A';
-        r1 = rand() % DIMEN;
-        c2 = (rand() % DIMEN) + 'A';
-        r2 = rand() % DIMEN;
+        c1 = (rng() % DIMEN) + 'A';
+        r1 = rng() % DIMEN;
+        c2 = (rng() % DIMEN) + 'A';
+        r2 = rng() % DIMEN;
     } while (!check_validity(c1, r1, c2, r2, 'W'));
     make_move(c1, r1, c2, r2);
 }
 
 //rando_r, the same process as rando, but in a reversed move order
-//parameters: an integer to add to the unix time seed, to increase randomness when multiple games
-//occur within a second
+//parameters: a seed for the opening's random number generator
 //returns: NA
-void Board::rando_r(int seed) {
+void Board::rando_r(uint64_t seed) {
     char c1, c2;
     int r1, r2;
-    srand(time(NULL) + seed);
+    mt19937_64 rng(seed); //own generator, so the same seed always gives the same opening
 
     //first move
     do {
-        c1 = (rand() % DIMEN) + 'A';
-        r1 = rand() % DIMEN;
-        c2 = (rand() % DIMEN) + 'A';
-        r2 = rand() % DIMEN;
+        c1 = (rng() % DIMEN) + 'A';
+        r1 = rng() % DIMEN;
+        c2 = (rng() % DIMEN) + 'A';
+        r2 = rng() % DIMEN;
     } while (!check_validity(c1, r1, c2, r2, 'B'));
     make_move(c1, r1, c2, r2);
 
     //second move
     do {
-        c1 = (rand() % DIMEN) + 'A';
-        r1 = rand() % DIMEN;
-        c2 = (rand() % DIMEN) + 'A';
-        r2 = rand() % DIMEN;
+        c1 = (rng() % DIMEN) + 'A';
+        r1 = rng() % DIMEN;
+        c2 = (rng() % DIMEN) + 'A';
+        r2 = rng() % DIMEN;
     } while (!check_validity(c1, r1, c2, r2, 'W'));
     make_move(c1, r1, c2, r2);
 
     //third move
     do {
-        c1 = (rand() % DIMEN) + 'A';
-        r1 = rand() % DIMEN;
-        c2 = (rand() % DIMEN) + 'A';
-        r2 = rand() % DIMEN;
+        c1 = (rng() % DIMEN) + 'A';
+        r1 = rng() % DIMEN;
+        c2 = (rng() % DIMEN) + 'A';
+        r2 = rng() % DIMEN;
     } while (!check_validity(c1, r1, c2, r2, 'B'));
     make_move(c1, r1, c2, r2);
 }
@@ -334,10 +531,11 @@ void Board::print_reverse() {
     cout << "   H  G  F  E  D  C  B  A\n";
 }
 
-//check_validity, checks that a proposed move is valid
-//parameters: 2 chars for columns, and 2 ints for rows of notations, string for the turn
+//check_validity, checks that a proposed move is valid, for the color given as the template parameter
+//parameters: 2 chars for columns, and 2 ints for rows of notations
 //returns: a bool indicating if the move is valid
-bool Board::check_validity(char column1, int row1, char column2, int row2, char turn) {
+template <char TURN>
+bool Board::check_validity(char column1, int row1, char column2, int row2) {
     char hold1 = toupper(column1);
     char hold2 = toupper(column2);
 
@@ -346,29 +544,29 @@ bool Board::check_validity(char column1, int row1, char column2, int row2, char
     ((hold2 - 'A') < 0) || (row2 > 7) || (row2 < 0))
         return false;
 
-    if ((abs(row2 - row1) != 2) && (forced_take(turn)))
+    if ((abs(row2 - row1) != 2) && (forced_take<TURN>()))
         return false;
 
     int col1 = hold1 - 'A'; //convert user-inputed chars to ints
     int col2 = hold2 - 'A';
 
     //Make sure that player is trying to move their own piece
-    if ((turn == 'W') && (((game_board[row1][col1] != WHITE_PIECE) && 
+    if ((TURN == 'W') && (((game_board[row1][col1] != WHITE_PIECE) && 
     (game_board[row1][col1] != WHITE_KING)) || (game_board[row2][col2] != BLACK_SQUARE))) {
         return false;
-    } else if ((turn == 'B') && (((game_board[row1][col1] != BLACK_PIECE) && 
+    } else if ((TURN == 'B') && (((game_board[row1][col1] != BLACK_PIECE) && 
     (game_board[row1][col1] != BLACK_KING)) || (game_board[row2][col2] != BLACK_SQUARE))) {
         return false;
     }
 
     //check that the particular piece can be moved that way
-    if ((turn == 'W') && (game_board[row1][col1] == WHITE_PIECE)) {
+    if ((TURN == 'W') && (game_board[row1][col1] == WHITE_PIECE)) {
         return white_piece_valid(col1, row1, col2, row2); //white regular piece
-    } else if ((turn == 'W') && (game_board[row1][col1] == WHITE_KING)) {
+    } else if ((TURN == 'W') && (game_board[row1][col1] == WHITE_KING)) {
         return white_king_valid(col1, row1, col2, row2); //white king
-    } else if ((turn == 'B') && (game_board[row1][col1] == BLACK_PIECE)) {
+    } else if ((TURN == 'B') && (game_board[row1][col1] == BLACK_PIECE)) {
         return black_piece_valid(col1, row1, col2, row2); //black piece
-    } else if ((turn == 'B') && (game_board[row1][col1] == BLACK_KING)) {
+    } else if ((TURN == 'B') && (game_board[row1][col1] == BLACK_KING)) {
         return black_king_valid(col1, row1, col2, row2); //black king
     }
 
@@ -382,6 +580,13 @@ void Board::make_move(char column1, int row1, char column2, int row2) {
     int col1 = toupper(column1) - 'A';
     int col2 = toupper(column2) - 'A';
     char taken = 'X';
+
+    //take the changed squares out of the hash, to be put back in with their new contents
+    hash ^= square_hash(row1, col1) ^ square_hash(row2, col2);
+    if (abs(row2 - row1) == 2)
+        hash ^= square_hash((row1 + row2) / 2, (col1 + col2) / 2);
+    if (just_kinged)
+        hash ^= kinged_key;
     
     game_board[row2][col2] = game_board[row1][col1];
     game_board[row1][col1] = BLACK_SQUARE;
@@ -413,6 +618,12 @@ void Board::make_move(char column1, int row1, char column2, int row2) {
 
     if (abs(row2 - row1) == 2)
         key[((((row1 + row2) / 2) * 8) / 2) + (((col1 + col2) / 2)) / 2] = BLACK_SQUARE;
+
+    hash ^= square_hash(row1, col1) ^ square_hash(row2, col2);
+    if (abs(row2 - row1) == 2)
+        hash ^= square_hash((row1 + row2) / 2, (col1 + col2) / 2);
+    if (just_kinged)
+        hash ^= kinged_key;
 }
 
 void Board::reverse_move(char column1, int row1, char column2, int row2, char taken, 
@@ -422,6 +633,12 @@ bool restore) {
     int col1 = hold1 - 'A';
     int col2 = hold2 - 'A';
 
+    hash ^= square_hash(row1, col1) ^ square_hash(row2, col2);
+    if (abs(row2 - row1) == 2)
+        hash ^= square_hash((row1 + row2) / 2, (col1 + col2) / 2);
+    if (just_kinged)
+        hash ^= kinged_key;
+
     game_board[row1][col1] = game_board[row2][col2];
     game_board[row2][col2] = BLACK_SQUARE;
 
@@ -458,6 +675,74 @@ bool restore) {
 
     if (abs(row2 - row1) == 2)
         key[((((row1 + row2) / 2) * 8) / 2) + (((col1 + col2) / 2)) / 2] = taken;
+
+    hash ^= square_hash(row1, col1) ^ square_hash(row2, col2);
+    if (abs(row2 - row1) == 2)
+        hash ^= square_hash((row1 + row2) / 2, (col1 + col2) / 2);
+    if (just_kinged)
+        hash ^= kinged_key;
+}
+
+//fill_zobrist, fills the random hash keys with a splitmix64 sequence from a fixed seed, so that 
+//hashes stay the same between runs and can be stored in files
+//parameters: NA
+//returns: a bool, so it can be run as a static initializer
+bool Board::fill_zobrist() {
+    uint64_t seed = 0x5468306D61734B31ULL;
+    uint64_t *keys[130];
+
+    for (int i = 0; i < 32; i++) {
+        for (int j = 0; j < 4; j++)
+            keys[(i * 4) + j] = &zobrist[i][j];
+    }
+    keys[128] = &kinged_key, keys[129] = &turn_key;
+
+    for (int i = 0; i < 130; i++) {
+        uint64_t z = (seed += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        *keys[i] = z ^ (z >> 31);
+    }
+
+    return true;
+}
+
+//square_hash, gets the hash key for the piece on a square, numbering squares as in the standard 
+//orientation
+//parameters: ints for the row and column
+//returns: the key, or 0 for an empty square
+uint64_t Board::square_hash(int row, int col) {
+    char piece = game_board[row][col];
+    if ((piece == BLACK_SQUARE) || (piece == BLANK))
+        return 0;
+
+    if (game_board[0][0] != BLANK)
+        col = DIMEN_LESS1 - col; //mirror a reversed board
+
+    int type = 3;
+    if (piece == BLACK_PIECE) {
+        type = 0;
+    } else if (piece == BLACK_KING) {
+        type = 1;
+    } else if (piece == WHITE_PIECE) {
+        type = 2;
+    }
+
+    return zobrist[((row * DIMEN) + col) / 2][type];
+}
+
+//rehash, computes the position hash from scratch
+//parameters: NA
+//returns: void
+void Board::rehash() {
+    hash = 0;
+    for (int i = 0; i < DIMEN; i++) {
+        for (int j = 0; j < DIMEN; j++)
+            hash ^= square_hash(i, j);
+    }
+
+    if (just_kinged)
+        hash ^= kinged_key;
 }
 
 //king_maker, helper function to make_move, scans back rows of board, converting men to kings
@@ -608,11 +893,13 @@ void Board::multi_hop_r(char turn) {
         multi_hop_r(turn); //recursive call if another hop possible
 }
 
-//jump_possible, checks if it's possible for a particular piece to take in any direction
-//parameters: a char for the piece's column, an int for the row, a string for the turn
+//jump_possible, checks if it's possible for a particular piece to take in any direction, for the color 
+//given as the template parameter
+//parameters: a char for the piece's column, an int for the row
 //returns: a bool if a take is possible
-bool Board::jump_possible(char col, int row, char turn) {
-    if (turn == 'W') {
+template <char TURN>
+bool Board::jump_possible(char col, int row) {
+    if (TURN == 'W') {
         if (col < 'G') {
             if ((row > 1) && ((game_board[row - 1][col + 1 - 'A'] == BLACK_PIECE) || 
             (game_board[row - 1][col + 1 - 'A'] == BLACK_KING)) && 
@@ -663,11 +950,13 @@ bool Board::jump_possible(char col, int row, char turn) {
     return false;
 }
 
-//move_possible, checks if it's possible for a particular piece to move one space in any direction
-//parameters: a char for the piece's column, an int for the row, a string for the turn
+//move_possible, checks if it's possible for a particular piece to move one space in any direction, for
+//the color given as the template parameter
+//parameters: a char for the piece's column, an int for the row
 //returns: a bool if a move is possible
-bool Board::move_possible(char col, int row, char turn) {
-    if (turn == 'W') {
+template <char TURN>
+bool Board::move_possible(char col, int row) {
+    if (TURN == 'W') {
         if (col < 'H') {
             if ((row > 0) && (game_board[row - 1][col + 1 - 'A'] == BLACK_SQUARE))
                 return true; //check up to the right
@@ -702,46 +991,6 @@ bool Board::move_possible(char col, int row, char turn) {
     return false;
 }
 
-bool Board::move_possible_w(char col, int row) {
-    if (col > 'A') {
-        if ((row > 0) && (game_board[row - 1][col - 1 - 'A'] == BLACK_SQUARE))
-            return true; //check up to the left
-        if ((row < DIMEN_LESS1) && (game_board[row + 1][col - 1 - 'A'] == BLACK_SQUARE) &&
-        (game_board[row][col - 'A'] == WHITE_KING))
-            return true; //check down to the left
-    }
-
-    if (col < 'H') {
-        if ((row > 0) && (game_board[row - 1][col + 1 - 'A'] == BLACK_SQUARE))
-            return true; //check up to the right
-        if ((row < DIMEN_LESS1) && (game_board[row + 1][col + 1 - 'A'] == BLACK_SQUARE) &&
-        (game_board[row][col - 'A'] == WHITE_KING))
-            return true; //check down to the right
-    }
-
-    return false;
-}
-
-bool Board::move_possible_b(char col, int row) {
-    if (col > 'A') {
-        if ((row > 0) && (game_board[row - 1][col - 1 - 'A'] == BLACK_SQUARE) &&
-        (game_board[row][col - 'A'] == BLACK_KING))
-            return true; //check up to the left
-        if ((row < DIMEN_LESS1) && (game_board[row + 1][col - 1 - 'A'] == BLACK_SQUARE))
-            return true; //check down to the left
-    }
-
-    if (col < 'H') {
-        if ((row > 0) && (game_board[row - 1][col + 1 - 'A'] == BLACK_SQUARE) &&
-        (game_board[row][col - 'A'] == BLACK_KING))
-            return true; //check up to the right
-        if ((row < DIMEN_LESS1) && (game_board[row + 1][col + 1 - 'A'] == BLACK_SQUARE))
-            return true; //check down to the right
-    }
-
-    return false;
-}
-
 //anything_possible, checks if a player has any possible moves
 //parameters: a string for the other player's color
 //returns: a bool for whether there's any possible moves
@@ -756,12 +1005,12 @@ bool Board::anything_possible(char turn) {
 bool Board::any_move(char turn) {
     if (turn == 'W') {
         for (int i = num_black - 1; i > -1; i--) {
-            if (move_possible_b((get_place_col_b(i) + 'A'), get_place_row_b(i)))
+            if (move_possible<'B'>((get_place_col_b(i) + 'A'), get_place_row_b(i)))
                 return true; //check each piece
         }
     } else {
         for (int i = num_white - 1; i > -1; i--) {
-            if (move_possible_w((get_place_col_w(i) + 'A'), get_place_row_w(i)))
+            if (move_possible<'W'>((get_place_col_w(i) + 'A'), get_place_row_w(i)))
                 return true; //check each piece
         }
     }
@@ -773,14 +1022,24 @@ bool Board::any_move(char turn) {
 //parameters: a string for the other player's color
 //returns: a bool for whether any taking move is possible
 bool Board::any_jump(char turn) {
-    if (turn == 'W') {
-        for (int i = 0; i < get_num_black(); i++) {
-            if (jump_possible((get_place_col_b(i) + 'A'), get_place_row_b(i), 'B'))
+    //switch around colors when calling forced_take
+    return (turn == 'W') ? forced_take<'B'>() : forced_take<'W'>();
+}
+
+//forced_take, checks whether a player, the color given as the template parameter, is forced to take
+//a piece
+//parameters: NA
+//returns: a bool for whether there is a forced take
+template <char TURN>
+bool Board::forced_take() {
+    if (TURN == 'W') {
+        for (int i = 0; i < num_white; i++) {
+            if (jump_possible<'W'>((get_place_col_w(i) + 'A'), get_place_row_w(i)))
                 return true; //check each piece
         }
     } else {
-        for (int i = 0; i < get_num_white(); i++) {
-            if (jump_possible((get_place_col_w(i) + 'A'), get_place_row_w(i), 'W'))
+        for (int i = 0; i < num_black; i++) {
+            if (jump_possible<'B'>((get_place_col_b(i) + 'A'), get_place_row_b(i)))
                 return true; //check each piece
         }
     }
@@ -788,18 +1047,6 @@ bool Board::any_jump(char turn) {
     return false; //false if nothing is found
 }
 
-//forced_take, checks whether a particular player is forced to take a piece
-//parameters: a string for the color of the player
-//returns: a bool for whether there is a forced take
-bool Board::forced_take(char turn) {
-    //switch around colors when calling any_jump
-    if (turn == 'W') {
-        return any_jump('B');
-    } else {
-        return any_jump('W');
-    }
-}
-
 //square, a getter for the content of a particular square on the board array, but with a safety check
 //so one does not go outside the bounds of the array, returning BLANK if so
 //parameters: an int for the row of the square, and another for the column
@@ -1036,10 +1283,11 @@ int Board::num_jumps(char col, int row) {
 }
 
 //simple_check, checks that a proposed move is valid without scanning for takes or capitalizing 
-//column inputs (be very careful with this one)
-//parameters: 2 chars for columns, and 2 ints for rows of notations, string for the turn
+//column inputs (be very careful with this one), for the color given as the template parameter
+//parameters: 2 chars for columns, and 2 ints for rows of notations
 //returns: a bool indicating if the move is valid
-bool Board::simple_check(char column1, int row1, char column2, int row2, char turn) {
+template <char TURN>
+bool Board::simple_check(char column1, int row1, char column2, int row2) {
     //Check that the positions are actually on the board
     if ((column2 - 'A' > DIMEN_LESS1) || (column2 - 'A' < 0) || (row2 > DIMEN_LESS1) || (row2 < 0))
         return false;
@@ -1049,7 +1297,7 @@ bool Board::simple_check(char column1, int row1, char column2, int row2, char tu
         return false;
 
     //check that the particular piece can be moved that way
-    if (turn == 'W') {
+    if (TURN == 'W') {
         if (game_board[row1][column1 - 'A'] == WHITE_PIECE) {
             return white_piece_valid(column1 - 'A', row1, column2 - 'A', row2); //white regular piece
         } else {
@@ -1065,16 +1313,16 @@ bool Board::simple_check(char column1, int row1, char column2, int row2, char tu
 }
 
 //same, compares the board to another to see if they are identical
-//parameters: another board to compare to
+//parameters: a ref to another board to compare to
 //returns: a bool indicating they are the same
-bool Board::same(Board ref2) {
+bool Board::same(const Board &ref2) {
     bool hold = false;
     if (game_board[0][0] == BLANK)
         hold = true;
 
     for (int i = 0; i < DIMEN; i++) {
         for (int j = hold; j < DIMEN; j += 2) {
-            if (game_board[i][j] != ref2.look(i, j)) {
+            if (game_board[i][j] != ref2.game_board[i][j]) {
                 return false;
             }
         }
@@ -1182,4 +1430,12 @@ bool Board::black_piece_valid(int col1, int row1, int col2, int row2) {
     return false;
 }
 
-
+//the colors the templated checks are used for
+template bool Board::check_validity<'W'>(char column1, int row1, char column2, int row2);
+template bool Board::check_validity<'B'>(char column1, int row1, char column2, int row2);
+template bool Board::simple_check<'W'>(char column1, int row1, char column2, int row2);
+template bool Board::simple_check<'B'>(char column1, int row1, char column2, int row2);
+template bool Board::jump_possible<'W'>(char col, int row);
+template bool Board::jump_possible<'B'>(char col, int row);
+template bool Board::forced_take<'W'>();
+template bool Board::forced_take<'B'>();
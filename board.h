@@ -5,6 +5,7 @@ hosting an interface for the user to make multiple jumps.*/
 #include <iostream>
 #include <cstdlib>
 #include <string>
+#include <stdint.h>
 
 using namespace std;
 
@@ -31,8 +32,19 @@ class Board {
         //game data
         char game_board[DIMEN][DIMEN];
 
-        //hashing key
-        string key;
+        //hashing key, kept in the Board rather than allocated, so Boards can be copied and thrown away
+        //without the allocator
+        char key[34];
+
+        //position hash, updated with every move. Squares are numbered as in the standard orientation,
+        //so a reversed board hashes the same as its mirror image.
+        uint64_t hash;
+
+        //random keys for each piece type on each square, for a piece having just been kinged, and 
+        //for white to move
+        static uint64_t zobrist[32][4];
+        static uint64_t kinged_key, turn_key;
+        static bool zobrist_ready;
         
         int last_move[4]; //records last move as array coordinates
 
@@ -64,14 +76,9 @@ class Board {
         //checks that a proposed move for a black piece is valid
         bool black_piece_valid(int col1, int row1, int col2, int row2);
 
-        //checks if it's possible for a piece to move one square
-        bool move_possible(char col, int row, char turn);
-
-        //more efficent, de-parametized version of move_possible for white pieces
-        bool move_possible_w(char col, int row);
-
-        //more efficent, de-parametized version of move_possible for black pieces
-        bool move_possible_b(char col, int row);
+        //checks if it's possible for a piece of a color to move one square
+        template <char TURN>
+        bool move_possible(char col, int row);
 
         //helper function to make_move, converts regular pieces to kings if called for
         void king_maker();
@@ -85,7 +92,19 @@ class Board {
         //undo the changes in the location arrays made at the last move
         void reverse_update(int col1, int row1, int col2, int row2, char taken);
 
+        //fills the random hash keys from a fixed seed, so hashes are the same in every run
+        static bool fill_zobrist();
+
+        //gets the hash key of the piece on a square, 0 if it's empty
+        uint64_t square_hash(int row, int col);
+
+        //recomputes the position hash from the board array
+        void rehash();
+
     public:
+        //longest FEN string, with twelve kings a side on squares 10 and up, and its terminating null
+        const static int FEN_SIZE = 100;
+
         //public functions
         //constructor
         Board();
@@ -93,14 +112,30 @@ class Board {
         //copy constructor
         Board(const Board &other);
 
+        //assignment, copies every member as is
+        Board& operator=(const Board &other) = default;
+
         //modify board for reverse orientation
         void reverse();
 
-        //play a random first three moves to create a tournament opening
-        void rando(int seed);
+        //set up an arbitrary position from the contents of the 32 playable squares
+        void setup(const char squares[32], bool reversed);
+
+        //turn the board around and swap the colors, so the other side can be searched as black
+        void flip();
+
+        //write the position as a PDN FEN string into a buffer, returns the length or -1 if
+        //it's smaller than FEN_SIZE
+        int to_fen(char turn, char buffer[], int size);
+
+        //set up a position from a PDN FEN string, returns false if it isn't valid
+        bool from_fen(const char text[], char &turn);
+
+        //play a random first three moves to create a tournament opening, from a given seed
+        void rando(uint64_t seed);
 
         //play a random first three moves to create a tournament opening, in reverse turn order
-        void rando_r(int seed);
+        void rando_r(uint64_t seed);
 
         //print board with white on bottom of display
         void print();
@@ -109,10 +144,24 @@ class Board {
         void print_reverse();
 
         //checks that a move is valid, returns a bool if so
-        bool check_validity(char column1, int row1, char column2, int row2, char turn);
+        bool check_validity(char column1, int row1, char column2, int row2, char turn) {
+            return (turn == 'W') ? check_validity<'W'>(column1, row1, column2, row2) : 
+            ((turn == 'B') && (check_validity<'B'>(column1, row1, column2, row2)));
+        }
+
+        //checks that a move for a color is valid, returns a bool if so
+        template <char TURN>
+        bool check_validity(char column1, int row1, char column2, int row2);
 
         //checks that a move is valid without scanning for takes, returns a bool if so
-        bool simple_check(char column1, int row1, char column2, int row2, char turn);
+        bool simple_check(char column1, int row1, char column2, int row2, char turn) {
+            return (turn == 'W') ? simple_check<'W'>(column1, row1, column2, row2) : 
+            simple_check<'B'>(column1, row1, column2, row2);
+        }
+
+        //checks that a move for a color is valid without scanning for takes, returns a bool if so
+        template <char TURN>
+        bool simple_check(char column1, int row1, char column2, int row2);
 
         //makes a move, modifying the board according to the entered notation
         void make_move(char column1, int row1, char column2, int row2);
@@ -145,10 +194,22 @@ class Board {
         bool any_jump(char turn);
 
         //checks if it's possible for a piece to take
-        bool jump_possible(char col, int row, char turn);
+        bool jump_possible(char col, int row, char turn) {
+            return (turn == 'W') ? jump_possible<'W'>(col, row) : jump_possible<'B'>(col, row);
+        }
+
+        //checks if it's possible for a piece of a color to take
+        template <char TURN>
+        bool jump_possible(char col, int row);
 
         //helper function to move_possible, checks for forced takes
-        bool forced_take(char turn);
+        bool forced_take(char turn) {
+            return (turn == 'W') ? forced_take<'W'>() : forced_take<'B'>();
+        }
+
+        //checks whether a color is forced to take
+        template <char TURN>
+        bool forced_take();
 
         //gets value at particular index array, for access by AI
         char square(int row, int column);
@@ -216,14 +277,19 @@ class Board {
         int num_jumps(char col, int row);
 
         //determines whether the Board is identical to another one
-        bool same(Board ref2);
+        bool same(const Board &ref2);
+
+        //get the position hash, for a given color to move
+        uint64_t get_hash(char turn) {
+            return (turn == 'W') ? (hash ^ turn_key) : hash;
+        }
 
         //get a pointer to the Board's hashing key
-        string* get_key() {
+        char* get_key() {
             key[32] = 'N';
             if (just_kinged)
                 key[32] = 'K';
-            return &key;
+            return key;
         }
 
 };
@@ -0,0 +1,145 @@
+/*.cpp file for the Book class, the opening book. The book file is mapped read-only, so loading it
+costs nothing up front and engines running at once share it through the page cache, and positions
+are found by binary search over the sorted entries.*/
+
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <random>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "book.h"
+
+using namespace std;
+
+//constructor, maps the book file and checks its header, leaving the book empty if it's missing or
+//doesn't match. The bytes after the header have to be whole entries, at least as many as it counts,
+//checked by division so a damaged count can't wrap around and pass.
+//parameters: a ref to the file name
+//returns: NA
+Book::Book(const string &name) {
+    base = NULL, length = 0;
+    entries = NULL, count = 0;
+
+    int fd = open(name.c_str(), O_RDONLY);
+    if (fd < 0)
+        return;
+
+    struct stat info;
+    if ((fstat(fd, &info) != 0) || ((size_t) info.st_size < sizeof(Book_header))) {
+        close(fd);
+        return;
+    }
+
+    void *mapped = mmap(NULL, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd); //the mapping keeps the file open
+    if (mapped == MAP_FAILED)
+        return;
+
+    const Book_header *header = (const Book_header*) mapped;
+    size_t rest = (size_t) info.st_size - sizeof(Book_header);
+    if ((header->magic != MAGIC) || (header->version != VERSION) || ((rest % sizeof(Book_entry)) != 0) ||
+    (header->entries > rest / sizeof(Book_entry))) {
+        munmap(mapped, info.st_size);
+        return;
+    }
+
+    base = (const uint8_t*) mapped, length = info.st_size;
+    entries = (const Book_entry*) (base + sizeof(Book_header));
+    count = header->entries;
+}
+
+//destructor, unmaps the book file
+//parameters: NA
+//returns: NA
+Book::~Book() {
+    if (base != NULL)
+        munmap((void*) base, length);
+}
+
+//find, binary searches for the first entry of a position
+//parameters: the position hash, a ref to a pointer to set to the first entry
+//returns: the number of entries for the position
+uint64_t Book::find(uint64_t key, const Book_entry *&first) {
+    uint64_t low = 0, high = count;
+
+    while (low < high) {
+        uint64_t mid = low + ((high - low) / 2);
+        if (entries[mid].key < key) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    first = entries + low;
+
+    uint64_t num = 0;
+    while ((low + num < count) && (entries[low + num].key == key))
+        num++;
+
+    return num;
+}
+
+//choose, picks a move for a position at random, weighted by how often it was played, among those
+//scoring within MARGIN of the best
+//parameters: the position hash, a ref to the caller's random number generator, a ref to an entry to
+//copy the move into
+//returns: a bool for whether the position was found
+bool Book::choose(uint64_t key, mt19937_64 &rng, Book_entry &out) {
+    const Book_entry *first;
+    uint64_t num = find(key, first);
+    if (num == 0)
+        return false;
+
+    int best = -32768;
+    for (uint64_t i = 0; i < num; i++) {
+        if (first[i].score > best)
+            best = first[i].score;
+    }
+
+    long total = 0;
+    for (uint64_t i = 0; i < num; i++) {
+        if (first[i].score >= best - MARGIN)
+            total += first[i].weight;
+    }
+    if (total == 0)
+        return false;
+
+    long pick = rng() % total;
+    for (uint64_t i = 0; i < num; i++) {
+        if (first[i].score < best - MARGIN)
+            continue;
+
+        pick -= first[i].weight;
+        if (pick < 0) {
+            out = first[i];
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//write_file, writes the header and entries of a book
+//parameters: a ref to the file name, a pointer to the entries, sorted by key, and their number
+//returns: a bool for whether the file was written
+bool Book::write_file(const string &name, const Book_entry *list, uint64_t num) {
+    Book_header header;
+    memset(&header, 0, sizeof(header));
+    header.magic = MAGIC, header.version = VERSION;
+    header.entries = num;
+
+    FILE *file = fopen(name.c_str(), "wb");
+    if (file == NULL)
+        return false;
+
+    bool written = (fwrite(&header, sizeof(header), 1, file) == 1) &&
+    ((num == 0) || (fwrite(list, sizeof(Book_entry), num, file) == num));
+
+    return (fclose(file) == 0) && written;
+}
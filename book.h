@@ -0,0 +1,72 @@
+/*book.h, the header file for the opening book. Holds the book file format, a sorted array of moves
+keyed by position hash, and the Book class, which maps a book file read-only and picks moves from it.
+
+Moves are stored as array coordinates in the standard orientation, and converted by the engine for
+a reversed board, since the position hash is the same for both orientations.*/
+
+#include <string>
+#include <random>
+#include <stdint.h>
+
+using namespace std;
+
+#ifndef BOOK_H
+#define BOOK_H
+
+//one book move, with how often it was played and its average result for the side that played it
+struct Book_entry {
+    uint64_t key;
+    uint8_t col1, row1, col2, row2;
+    uint16_t weight;
+    int16_t score;
+};
+
+//fixed-size header at the start of the book file, followed by the entries sorted by key
+struct Book_header {
+    uint32_t magic, version;
+    uint64_t entries;
+};
+
+class Book {
+    private:
+        //mapped file, NULL if there is no usable book
+        const uint8_t *base;
+        size_t length;
+
+        //the sorted entries inside the mapping, and how many there are
+        const Book_entry *entries;
+        uint64_t count;
+
+    public:
+        /***Constants***/
+
+        //file identification
+        const static uint32_t MAGIC = 0x4B4F4F42, VERSION = 1;
+
+        //scores are stored as a thousandth of a win per game, moves scoring this far below the best
+        //aren't played
+        const static int MARGIN = 150;
+
+        //constructor, maps a book file if it exists
+        Book(const string &name);
+
+        //destructor, unmaps the file
+        ~Book();
+
+        //whether a book was loaded
+        bool loaded() {
+            return (base != NULL);
+        }
+
+        //find the entries for a position, returns the number of them, which follow first
+        uint64_t find(uint64_t key, const Book_entry *&first);
+
+        //pick one of a position's moves, weighted by how often it was played, returns false if
+        //the position isn't in the book
+        bool choose(uint64_t key, mt19937_64 &rng, Book_entry &out);
+
+        //write entries, which must be sorted by key, to a book file, returns false on failure
+        static bool write_file(const string &name, const Book_entry *list, uint64_t num);
+};
+
+#endif
@@ -0,0 +1,222 @@
+/*bookgen.cpp, the main for the opening book builder. Plays games between Thomas and Hayden from the
+same random three-move openings used in Thomas vs. Hayden mode, searching every move at the given
+difficulty level, and records the position and move at each turn of the opening. Each move in the
+book is weighted by how often the searches chose it, and scored by the results of the games it was
+played in.
+
+Thomas doesn't use an existing book while building, so the book comes from searches alone. Games
+running past MAX_TURNS are called for whoever has more pieces, or drawn if the pieces are equal.
+
+Every game's opening and engine seeds are drawn from one seed, printed at the start, so a book can be
+rebuilt exactly with -s, as long as the level isn't a timed one.
+
+Usage: ./bookgen [-g games] [-l level] [-p plies] [-s seed] [-m hash MB] [-o file]*/
+
+#include <iostream>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <map>
+#include <random>
+#include <ctime>
+#include "board.h"
+#include "AI.h"
+#include "AI_r.h"
+#include "book.h"
+
+using namespace std;
+
+//number of turns after which a game is adjudicated
+const int MAX_TURNS = 300;
+
+//a move made in the opening of a game, keyed by the position hash with the side to move
+struct Played {
+    uint64_t key;
+    uint32_t move;
+    char turn;
+};
+
+//number of games a move was played in, and the sum of their results for the side that played it
+struct Tally {
+    long played;
+    long result;
+};
+
+//play one game, recording the opening moves, returns 1 for a black win, -1 for a white win, or 0
+int play_game(mt19937_64 &seeds, bool alt, int level, int plies, int hash, vector<Played> &played);
+
+//pack a move into an int, with columns as numbers
+uint32_t pack_move(int col1, int row1, int col2, int row2);
+
+int main(int argc, char *argv[]) {
+    int games = 100, level = 2, plies = 16, hash = 0;
+    uint64_t seed = time(NULL);
+    string name = "book.bin";
+
+    for (int i = 1; i < argc; i++) {
+        if ((!strcmp(argv[i], "-g")) && (i + 1 < argc)) {
+            games = atoi(argv[++i]);
+        } else if ((!strcmp(argv[i], "-l")) && (i + 1 < argc)) {
+            level = atoi(argv[++i]);
+        } else if ((!strcmp(argv[i], "-p")) && (i + 1 < argc)) {
+            plies = atoi(argv[++i]);
+        } else if ((!strcmp(argv[i], "-s")) && (i + 1 < argc)) {
+            seed = strtoull(argv[++i], NULL, 10);
+        } else if ((!strcmp(argv[i], "-m")) && (i + 1 < argc)) {
+            hash = atoi(argv[++i]);
+        } else if ((!strcmp(argv[i], "-o")) && (i + 1 < argc)) {
+            name = argv[++i];
+        } else {
+            cout << "Usage: " << argv[0] << " [-g games] [-l level] [-p plies] [-s seed] [-m hash MB] [-o file]\n";
+            return 1;
+        }
+    }
+
+    if ((level < 1) || (level > 5)) {
+        cout << "Level must be between 1 and 5\n";
+        return 1;
+    }
+
+    map<pair<uint64_t, uint32_t>, Tally> tallies;
+    int black = 0, white = 0, draws = 0;
+    bool alt = true;
+    mt19937_64 seeds(seed);
+    cout << "Seed: " << seed << endl;
+
+    for (int x = 0; x < games; x++) {
+        vector<Played> played;
+        int result = play_game(seeds, alt, level, plies, hash, played);
+        alt = (!alt);
+
+        if (result > 0) {
+            black++;
+        } else if (result < 0) {
+            white++;
+        } else {
+            draws++;
+        }
+
+        for (size_t i = 0; i < played.size(); i++) {
+            Tally &tally = tallies[make_pair(played[i].key, played[i].move)];
+            tally.played++;
+            tally.result += (played[i].turn == 'B') ? result : -result;
+        }
+
+        cout << "Game " << x + 1 << ": black " << black << ", white " << white << ", draws " << draws
+        << ", " << tallies.size() << " book moves\n";
+    }
+
+    //the map is ordered by key already
+    vector<Book_entry> entries;
+    for (map<pair<uint64_t, uint32_t>, Tally>::iterator i = tallies.begin(); i != tallies.end(); i++) {
+        Book_entry entry;
+        memset(&entry, 0, sizeof(entry));
+        entry.key = i->first.first;
+        entry.col1 = (i->first.second >> 24) & 0xFF, entry.row1 = (i->first.second >> 16) & 0xFF;
+        entry.col2 = (i->first.second >> 8) & 0xFF, entry.row2 = i->first.second & 0xFF;
+        entry.weight = (i->second.played < 65535) ? i->second.played : 65535;
+        entry.score = (1000 * i->second.result) / i->second.played;
+        entries.push_back(entry);
+    }
+
+    if (!Book::write_file(name, entries.empty() ? NULL : &entries[0], entries.size())) {
+        cout << "Could not write " << name << endl;
+        return 1;
+    }
+
+    cout << "Wrote " << entries.size() << " moves to " << name << endl;
+
+    return 0;
+}
+
+//pack_move, packs a move's array coordinates into one int
+//parameters: ints for the first column and row, and the second column and row
+//returns: the packed move
+uint32_t pack_move(int col1, int row1, int col2, int row2) {
+    return (col1 << 24) | (row1 << 16) | (col2 << 8) | row2;
+}
+
+//play_game, plays a game between Thomas as black and Hayden as white without printing, the same
+//way as Thomas vs. Hayden mode, recording the first move of every turn before the ply limit
+//parameters: a ref to the generator to draw the opening and engine seeds from, a bool for whether the
+//opening starts with black, an int for the difficulty level, an int for the number of plies to
+//record, an int for Thomas's table size in megabytes, 0 for the default, a ref to the record
+//returns: an int for the result, 1 for a black win, -1 for a white win, 0 for a draw
+int play_game(mt19937_64 &seeds, bool alt, int level, int plies, int hash, vector<Played> &played) {
+    Board game;
+    char move;
+    uint64_t opening = seeds(), Thomas_seed = seeds(), Hayden_seed = seeds();
+
+    if (alt) {
+        move = 'W';
+        game.rando_r(opening);
+    } else {
+        move = 'B';
+        game.rando(opening);
+    }
+
+    AI Thomas;
+    AI_r Hayden;
+    Thomas.set_difficulty(level), Hayden.set_difficulty(level);
+    Thomas.set_seed(Thomas_seed), Hayden.set_seed(Hayden_seed);
+    Thomas.use_book(false);
+    if (hash > 0)
+        Thomas.set_hash(hash);
+
+    for (int turns = 3; turns < MAX_TURNS; turns++) {
+        Played entry;
+        entry.key = game.get_hash(move), entry.turn = move;
+
+        if (move == 'B') {
+            Thomas.update_AI(game);
+            Thomas.move(true);
+            entry.move = pack_move(Thomas.get_col1() - 'A', Thomas.get_row1(), Thomas.get_col2() - 'A',
+            Thomas.get_row2());
+            game.make_move(Thomas.get_col1(), Thomas.get_row1(), Thomas.get_col2(), Thomas.get_row2());
+
+            if ((abs(Thomas.get_row2() - Thomas.get_row1()) == 2) &&
+            (game.jump_possible(Thomas.get_col2(), Thomas.get_row2(), 'B')) && (!game.kinged())) {
+                bool another = false;
+                do {
+                    another = Thomas.multi(true);
+                    game.make_move(Thomas.get_col1(), Thomas.get_row1(), Thomas.get_col2(),
+                    Thomas.get_row2());
+                } while (another);
+            }
+        } else {
+            Hayden.update_AI(game);
+            Hayden.move();
+            entry.move = pack_move(Hayden.get_col1() - 'A', Hayden.get_row1(), Hayden.get_col2() - 'A',
+            Hayden.get_row2());
+            game.make_move(Hayden.get_col1(), Hayden.get_row1(), Hayden.get_col2(), Hayden.get_row2());
+
+            if ((abs(Hayden.get_row2() - Hayden.get_row1()) == 2) &&
+            (game.jump_possible(Hayden.get_col2(), Hayden.get_row2(), 'W')) && (!game.kinged())) {
+                bool another = false;
+                do {
+                    another = Hayden.multi();
+                    game.make_move(Hayden.get_col1(), Hayden.get_row1(), Hayden.get_col2(),
+                    Hayden.get_row2());
+                } while (another);
+            }
+        }
+
+        if (turns < plies)
+            played.push_back(entry);
+
+        //the last side able to move wins
+        if (game.check_win(move))
+            return (move == 'B') ? 1 : -1;
+
+        move = (move == 'B') ? 'W' : 'B';
+    }
+
+    if (game.get_num_black() > game.get_num_white()) {
+        return 1;
+    } else if (game.get_num_white() > game.get_num_black()) {
+        return -1;
+    }
+
+    return 0;
+}
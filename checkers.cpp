@@ -1,4 +1,4 @@
-/*checkers.cpp, the main for the Thomas program. Has three modes. In mode 1, the user plays 
+/*checkers.cpp, the main for the Thomas program. Has four modes. In mode 1, the user plays 
 against the Thomas AI as red. In mode 2, the user plays against Thomas as black. In mode 3, 
 Thomas plays 10,000 games against a color reversed copy of itself, Hayden, so that the effect of 
 strategy changes on gameplay can be observed statistially. In each mode, the AI(s) can be set to 
@@ -7,7 +7,20 @@ first three moves are chosen randomly and turn order switched between games, to
 of games.
 
 Moves are entered using chess notation, rather than checkers notation, as this is more intuitive to 
-use in the terminal environment.*/
+use in the terminal environment.
+
+Mode 3 draws every game's opening and engine seeds from one tournament seed, printed at the start, 
+so a run of untimed games can be replayed exactly by passing the seed back in: ./Thomas [seed]
+Each finished game is appended to games.rec, as its starting position and moves, with the result.
+
+Mode 4 is mode 3 with Hayden replaced by Monty, who decides by Monte Carlo tree search instead of 
+minimax, on every core at the timed levels.
+
+In modes 3 and 4, once a game is lopsided, nearly over or long, a proof-number solver tries to prove it
+won, and the game is called for the winner as soon as it does, instead of being played out.
+
+Thomas ponders, searching the reply he expects on the opponent's time, against the player and, at the
+timed levels, against Hayden.*/
 
 #include <iostream>
 #include <string>
@@ -17,24 +30,37 @@ use in the terminal environment.*/
 #include <cctype>
 #include <unistd.h>
 #include <thread>
+#include <random>
+#include <ctime>
 #include "board.h"
 #include "AI.h"
 #include "AI_r.h"
+#include "AI_m.h"
+#include "record.h"
+#include "solver.h"
 
 using namespace std;
 
 //Board dimensions are used for notation conversion
 const int DIMEN = 8;
 
+//when the solver tries to settle a game in modes 3 and 4: from a lead of this many pieces, at this many pieces
+//left, or after this many turns, every so many turns, searching up to this many positions for each side,
+//with a table of this many megabytes
+const int SOLVE_MARGIN = 2, SOLVE_PIECES = 8, SOLVE_TURNS = 200, SOLVE_EVERY = 4;
+const long long SOLVE_NODES = 100000;
+const int SOLVE_MB = 64;
+
 //player vs. Thomas with player as white
 void v_AI_w();
 
 //player vs. Thomas with player as black
 void v_AI_b();
 
-//function for having Thomas play against a color-reversed copy, Hayden, for strength of gameplay 
-//with different changes 
-void AI_v_AI();
+//function for having Thomas play against a color-reversed copy, Hayden, or the Monte Carlo AI, Monty,
+//for strength of gameplay with different changes, from a tournament seed
+template <class Rival>
+void AI_v_AI(uint64_t seed);
 
 //get the desired difficulty level
 int get_level();
@@ -43,56 +69,64 @@ int get_level();
 string stripNonAlphaNum(string input);
 
 //get the player's desired move, putting the notation into existing variables
-void get_move(string &input, Board *&game, vector<Board> &path, AI &Thomas, bool &go, 
+void get_move(string &input, Board *&game, Record &path, AI &Thomas, bool &go, 
 char &col1, int &row1, char &col2, int &row2, int &turns, bool flipped);
 
 //cleans inputted user moves, and performs move undo action if command is entered
-void format(string &input, Board *&game, vector<Board> &path, AI &Thomas, int &turns, 
+void format(string &input, Board *&game, Record &path, AI &Thomas, int &turns, 
 bool flipped);
 
 //perform operations for the end of a player/AI move necessary to maintain game flow
-void end_move(char &move, vector<Board> &path, Board *game, int &turns, bool over);
+void end_move(char &move, Record &path, Board *game, int &turns, bool over);
 
 //request move coordinates from Thomas, and then execute that move on the board
-void Thomas_turn(char &move, vector<Board> &path, Board *&game, int &turns, bool &over,
+void Thomas_turn(char &move, Record &path, Board *&game, int &turns, bool &over,
 AI &Thomas, bool flipped);
 
-//request move coordinates from Hayden, and then execute that move on the board
-void Hayden_turn(char &move, vector<Board> &path, Board *&game, int &turns, bool &over,
-AI_r &Hayden, bool flipped);
+//request move coordinates from Thomas's opponent in modes 3 and 4, and then execute that move on the board
+template <class Rival>
+void rival_turn(char &move, Record &path, Board *&game, int &turns, bool &over,
+Rival &Hayden, bool flipped);
 
 //run the player move input-output sequence, and then execute the player's moves/commands
-void player_turn(char &move, vector<Board> &path, Board *&game, int &turns, bool &over,
+void player_turn(char &move, Record &path, Board *&game, int &turns, bool &over,
 AI &Thomas, bool flipped);
 
 //runs the print or reverse print functions of the board object depending on a bool for the orientation
 void auto_print(Board *&game, bool flipped);
 
 //adjudicate games between Thomas and Hayden when they've gone on for too long
-void referee(char &move, Board *&game, int &turns, vector<Board> &path, bool &over, 
+void referee(char &move, Board *&game, int &turns, Record &path, bool &over, 
 bool &tied);
 
+//end a game in modes 3 and 4 as soon as the solver proves it won for either side
+void solve_ending(char &move, Board *game, int turns, bool &over, Solver &solver);
+
 //keep track of wins, losses and draws when Thomas and Hayden play a series of games
-void track(char move, Board *&game, bool over, bool &tied, bool &alt, int &T, int &H, int &Tie);
+void track(char move, Board *&game, bool over, bool &tied, bool &alt, int &T, int &H, int &Tie, 
+const string &rival);
 
-int main() {
+int main(int argc, char *argv[]) {
+    uint64_t seed = (argc > 1) ? strtoull(argv[1], NULL, 10) : time(NULL);
     int mode = 0;
     bool chosen = false;
     cout << "Play Thomas as red (enter 1), as black (2), or launch Thomas vs. Hayden experimental"; 
-    cout << " mode (3)\n";
+    cout << " mode (3), or Thomas vs. Monty (4)\n";
 
     //run input loop until a valid number is entered
     do {
         if (cin >> mode)
             chosen = true;
-    } while ((!chosen) || ((mode != 1) && (mode != 2) && (mode != 3)));
+    } while ((!chosen) || ((mode != 1) && (mode != 2) && (mode != 3) && (mode != 4)));
 
     if (mode == 1) {
         v_AI_w(); //player as white
     } else if (mode == 2) {
         v_AI_b(); //player as black
+    } else if (mode == 3) {
+        AI_v_AI<AI_r>(seed); //Thomas vs. Hayden
     } else {
-        AI_v_AI(); //Thomas vs. Hayden
+        AI_v_AI<AI_m>(seed); //Thomas vs. Monty
     }
 
     system("say game over!");
@@ -107,11 +141,11 @@ int main() {
 //returns: void
 void v_AI_w() {
     Board *game = new Board;
-    vector <Board> path;
-    path.push_back(*game);
+    Record path(*game, 'W');
     
     AI Thomas; //declare Thomas and set his difficulty
     Thomas.set_difficulty(get_level());
+    Thomas.use_ponder(true); //think on the player's time
     Thomas.update_AI(*game); //update Thomas at start because it goes first
 
     game->print();
@@ -146,12 +180,12 @@ void v_AI_w() {
 //returns: void
 void v_AI_b() {
     Board *game = new Board;
-    vector <Board> path;
     game->reverse(); //set up game with reversed columnar orientation
-    path.push_back(*game);
+    Record path(*game, 'B');
     
     AI Thomas;
     Thomas.set_difficulty(get_level());
+    Thomas.use_ponder(true); //think on the player's time
     Thomas.update_AI(*game); //update Thomas at start because it goes first
 
     game->print_reverse(); //print black pieces as their red equivalents and vice versa
@@ -178,34 +212,40 @@ void v_AI_b() {
 }
 
 //AI_v_AI, similar to the Thomas vs. player functions, but with Thomas playing against another AI, 
-//Hayden, and a series of variables to keep track of past games. Additionally, to increase game 
-//variation, switches who goes first every game and runs the first three moves randomly, similar to 
-//procedure for tournament play
-//parameters: NA
+//Hayden or Monty, given as the template parameter, and a series of variables to keep track of past 
+//games. Additionally, to increase game variation, switches who goes first every game and runs the 
+//first three moves randomly, similar to procedure for tournament play
+//parameters: a seed for the tournament's random number generator
 //returns: void
-void AI_v_AI() {
+template <class Rival>
+void AI_v_AI(uint64_t seed) {
     int T = 0, H = 0, Tie = 0; //counters for wins and draws
     bool alt = true;
     char move;
     int both = get_level();
-    srand(time(NULL));
+    mt19937_64 tournament(seed); //draws the seeds for each game
+    Record_writer games("games.rec"); //every finished game is appended here
+    Solver solver(SOLVE_MB); //proofs are kept from game to game
+    cout << "Tournament seed: " << seed << endl;
     for (int x = 0; x < 100; x++) {
     Board *game = new Board;
+    uint64_t opening = tournament(), Thomas_seed = tournament(), Hayden_seed = tournament();
 
     //change turn order and random opening procedure
     if (alt) {
         move = 'W';
-        game->rando_r(x); //seed each random opening with a time-independent second value
+        game->rando_r(opening);
     } else {
         move = 'B';
-        game->rando(x); //seed each random opening with a time-independent second value
+        game->rando(opening);
     }
     
-    vector <Board> path;
-    path.push_back(*game);
+    Record path(*game, move);
     AI Thomas;
-    AI_r Hayden;
+    Rival Hayden;
     Thomas.set_difficulty(both), Hayden.set_difficulty(both);
+    Thomas.set_seed(Thomas_seed), Hayden.set_seed(Hayden_seed);
+    Thomas.use_ponder(both > 3); //only the timed levels, which can't be replayed exactly anyway
     int turns = 0;
     bool over = false, tied = false;
 
@@ -217,7 +257,7 @@ void AI_v_AI() {
     while (!over) {
         if (move == 'W') {
             Hayden.update_AI(*game);
-            Hayden_turn(move, path, game, turns, over, Hayden, false);
+            rival_turn(move, path, game, turns, over, Hayden, false);
             Thomas.update_AI(*game);
             //system("sleep 1");
         } else if (move == 'B') {
@@ -227,9 +267,12 @@ void AI_v_AI() {
         }
 
         referee(move, game, turns, path, over, tied); //adjudicate non-progressing games
+        if (!over)
+            solve_ending(move, game, turns, over, solver); //and decided ones
     }
 
-    track(move, game, over, tied, alt, T, H, Tie); //keep track of game record
+    games.write(path, tied ? 'D' : ((move == 'W') ? 'B' : 'W'));
+    track(move, game, over, tied, alt, T, H, Tie, Hayden.get_name()); //keep track of game record
     }
 }
 
@@ -250,10 +293,10 @@ string stripNonAlphaNum(string input) {
 
 //get_move, ask the player for moves/undo commands, execute undo commands and sanitize/
 //check validity for proposed moves
-//parameters: a ref to the input string, the game object and vector record, a ref to Thomas, variables 
+//parameters: a ref to the input string, the game object and game record, a ref to Thomas, variables 
 //for the indicated move, the go bool and turn number int, and a bool for whether to flip notation
 //returns: void
-void get_move(string &input, Board *&game, vector<Board> &path, AI &Thomas,
+void get_move(string &input, Board *&game, Record &path, AI &Thomas,
 bool &go, char &col1, int &row1, char &col2, int &row2, int &turns, bool flipped) {
     go = false;
     
@@ -287,11 +330,11 @@ bool &go, char &col1, int &row1, char &col2, int &row2, int &turns, bool flipped
 }
 
 //format, sanitize tita, check for a perform undo commands, loop until input is valid notation
-//parameters: a ref to the input string, the game board pointer and vector record, a printable string 
+//parameters: a ref to the input string, the game board pointer and game record, a printable string 
 //corresponding to the player's color, a ref to Thomas, an int for the number of turns and a bool for 
 //whether the colors are reversed
 //returns: void
-void format(string &input, Board *&game, vector<Board> &path, AI &Thomas,
+void format(string &input, Board *&game, Record &path, AI &Thomas,
 int &turns, bool flipped) {
     while (((getline(cin, input) && (input.length() != 4))) || (!isalpha(input[0])) || 
     (!isdigit(input[1])) || (!isalpha(input[2])) || (!isdigit(input[3]))) {
@@ -306,10 +349,9 @@ int &turns, bool flipped) {
                     input = "";
                 } else {
                     delete game;
-                    game = new Board(path[turns - 2]); //replace board object with past copy
+                    game = new Board(path.position(turns - 2)); //replace board object with past copy
                     turns -= 2; //set back counter
-                    path.pop_back();
-                    path.pop_back();
+                    path.truncate(turns);
                     Thomas.update_AI(*game);
                     auto_print(game, flipped);
 
@@ -331,12 +373,12 @@ int &turns, bool flipped) {
 
 //end_move, records a move in the record, updates the turn counter, switches turn status, and prints 
 //an end-of-game message if the game has been won
-//parameters: a ref to the string indicating whose move it is, the vector record, a pointer to the game 
+//parameters: a ref to the string indicating whose move it is, the game record, a pointer to the game 
 //board, a ref to the turn number, a bool for whether the game is over
 //returns: void
-void end_move(char &move, vector<Board> &path, Board *game, int &turns, bool over) {
+void end_move(char &move, Record &path, Board *game, int &turns, bool over) {
     //record move
-    path.push_back(*game);
+    path.add_turn(*game);
     turns++;
 
     //game is won by last player to be able to move
@@ -358,20 +400,16 @@ void end_move(char &move, vector<Board> &path, Board *game, int &turns, bool ove
 
 //Thomas_turn, ask Thomas for its move, execute it on the board, make multiple jumps if possible, 
 //then end the turn and change colors
-//parameters: a ref to the move string, the vector record, a pointer to the game board, a ref to the 
+//parameters: a ref to the move string, the game record, a pointer to the game board, a ref to the 
 //turn number, a bool for whether the game is over, a ref to Thomas, and a bool for whether to flip
 //returns: void
-void Thomas_turn(char &move, vector<Board> &path, Board *&game, int &turns, bool &over,
+void Thomas_turn(char &move, Record &path, Board *&game, int &turns, bool &over,
 AI &Thomas, bool flipped) {
     cout << "Thomas goes\n";
     cout << "...\n";
     
-    if ((turns > 16) && (((game->same(path[turns - 4])) && (game->same(path[turns - 8]))) ||
-    ((game->same(path[turns - 8])) && (game->same(path[turns - 16]))))) {
-        Thomas.move(true, true); //if caught in a loop, play a different, slightly worse move
-    } else {
-        Thomas.move(false, true); //play the best move
-    }
+    Thomas.set_history(path.get_history()); //so moves back into earlier positions score as draws
+    Thomas.move(true); //play the best move
     
     game->make_move(Thomas.get_col1(), Thomas.get_row1(), Thomas.get_col2(), 
     Thomas.get_row2()); //make move
@@ -396,24 +434,24 @@ AI &Thomas, bool flipped) {
     }
 
     end_move(move, path, game, turns, over);
+
+    if (!over)
+        Thomas.ponder(); //search the expected reply while the opponent thinks
 }
 
-//Hayden_turn, ask Hayden for its move, execute it on the board, make multiple jumps if possible, 
-//then end the turn and change colors
-//parameters: a ref to the move string, the vector record, a pointer to the game board, a ref to the 
-//turn number, a bool for whether the game is over, a ref to Hayden, and a bool for whether to flip
+//rival_turn, ask Thomas's opponent, Hayden or Monty, for its move, execute it on the board, make 
+//multiple jumps if possible, then end the turn and change colors
+//parameters: a ref to the move string, the game record, a pointer to the game board, a ref to the 
+//turn number, a bool for whether the game is over, a ref to the opponent, and a bool for whether to flip
 //returns: void
-void Hayden_turn(char &move, vector<Board> &path, Board *&game, int &turns, bool &over,
-AI_r &Hayden, bool flipped) {
-    cout << "Hayden goes\n";
+template <class Rival>
+void rival_turn(char &move, Record &path, Board *&game, int &turns, bool &over,
+Rival &Hayden, bool flipped) {
+    cout << Hayden.get_name() << " goes\n";
     cout << "...\n";
     
-    if ((turns > 16) && (((game->same(path[turns - 4])) && (game->same(path[turns - 8]))) ||
-    ((game->same(path[turns - 8])) && (game->same(path[turns - 16]))))) {
-        Hayden.move(true); //if caught in a loop, play a different, slightly worse move
-    } else {
-        Hayden.move(false); //play the best move
-    }
+    Hayden.set_history(path.get_history()); //so moves back into earlier positions score as draws
+    Hayden.move(); //play the best move
     
     game->make_move(Hayden.get_col1(), Hayden.get_row1(), Hayden.get_col2(), 
     Hayden.get_row2()); //make move
@@ -426,7 +464,7 @@ AI_r &Hayden, bool flipped) {
     (!game->kinged())) {
         bool another = false;
         do {
-            cout << "Hayden jumps again\n";
+            cout << Hayden.get_name() << " jumps again\n";
             cout << "...\n";
             another = Hayden.multi(); //jump again if possible after this jump
             game->make_move(Hayden.get_col1(), Hayden.get_row1(), Hayden.get_col2(), 
@@ -441,9 +479,9 @@ AI_r &Hayden, bool flipped) {
 
 //player_turn, prompt the player for their move, execute it, go the board object based multiple jump 
 //sequence if possible, then update Thomas
-//parameters: a ref to the move string, the vector record, a pointer to the game board, a ref to the 
+//parameters: a ref to the move string, the game record, a pointer to the game board, a ref to the 
 //turn number, a bool for whether the game is over, a ref to Thomas, and a bool for whether to flip
-void player_turn(char &move, vector<Board> &path, Board *&game, int &turns, bool &over,
+void player_turn(char &move, Record &path, Board *&game, int &turns, bool &over,
 AI &Thomas, bool flipped) {
     //move execution variables
     char col1, col2;
@@ -485,14 +523,26 @@ void auto_print(Board *&game, bool flipped) {
 }
 
 //referee, used in AI_v_AI, calls a game if it's gone on for too long without progress
-//parameters: a string for the move, a pointer to the game Board, the vector record, a bool ref for 
+//parameters: a string for the move, a pointer to the game Board, the game record, a bool ref for 
 //whether the game is over, a bool ref for whether the game is a tie
 //returns: void
-void referee(char &move, Board *&game, int &turns, vector<Board> &path, bool &over, 
+void referee(char &move, Board *&game, int &turns, Record &path, bool &over, 
 bool &tied) {
+    //call a draw once the same position has come up three times
+    if (path.repetitions() >= 3) {
+        over = true;
+        tied = true;
+        cout << "Draw, by repetition\n";
+        return;
+    }
+
+    if (turns <= 200)
+        return;
+
     //call a draw if pieces are equal and no takes have happened for 200 moves
-    if ((turns > 200) && (game->get_num_black() == path[turns - 100].get_num_black()) &&
-    (game->get_num_white() == path[turns - 100].get_num_white()) && 
+    Board past = path.position(turns - 100);
+    if ((game->get_num_black() == past.get_num_black()) &&
+    (game->get_num_white() == past.get_num_white()) && 
     (game->get_num_black() == game->get_num_white())) {
         over = true;
         tied = true;
@@ -500,8 +550,12 @@ bool &tied) {
     }
 
     //if one player has more pieces, call a win for them if nothing has been taken in 1000 moves
-    if ((turns > 400) && (game->get_num_black() == path[turns - 200].get_num_black()) &&
-    (game->get_num_white() == path[turns - 200].get_num_white()) &&
+    if (turns <= 400)
+        return;
+
+    past = path.position(turns - 200);
+    if ((game->get_num_black() == past.get_num_black()) &&
+    (game->get_num_white() == past.get_num_white()) &&
     game->get_num_black() != game->get_num_white()) {
         over = true;
         if (game->get_num_white() > game->get_num_black()) {
@@ -514,12 +568,42 @@ bool &tied) {
     }
 }
 
+//solve_ending, once a game has a clear leader, few pieces left or has gone on long, has the solver try
+//to prove it won or lost for the side to move, and calls the game if it does, so decided endgames
+//aren't played out for hundreds of moves. Only forced wins are called, never draws.
+//parameters: a char ref for the color to move, set to the loser if the game's called, a pointer to the
+//game Board, an int for the number of turns, a bool ref for whether the game's over, a ref to the Solver
+//returns: void
+void solve_ending(char &move, Board *game, int turns, bool &over, Solver &solver) {
+    int black = game->get_num_black(), white = game->get_num_white();
+    if ((abs(black - white) < SOLVE_MARGIN) && (black + white > SOLVE_PIECES) && (turns <= SOLVE_TURNS))
+        return;
+
+    if (turns % SOLVE_EVERY != 0)
+        return;
+
+    uint8_t result = solver.solve(*game, move, SOLVE_NODES);
+    if (result == Solver::UNKNOWN)
+        return;
+
+    over = true;
+    if (result == Solver::WIN)
+        move = (move == 'B') ? 'W' : 'B';
+
+    if (move == 'B') {
+        cout << "Solved, win for red\n";
+    } else {
+        cout << "Solved, win for black\n";
+    }
+}
+
 //track, keep track of wins and losses in AI_v_AI mode, uptiting a displaying counters
 //parameters: a string for the move, a pointer to the game Board, a bool for whether the game is 
 //over, a bool ref for whether it's tied, a bool for ref for the alternation bool, int refs for the Thomas 
-//win, Hayden win, and tie counters
+//win, opponent win, and tie counters, and a string for the opponent's name
 //returns: void
-void track(char move, Board *&game, bool over, bool &tied, bool &alt, int &T, int &H, int &Tie) {
+void track(char move, Board *&game, bool over, bool &tied, bool &alt, int &T, int &H, int &Tie, 
+const string &rival) {
     //count a win
     if ((over) && (!tied)) {
         if (move == 'W') {
@@ -538,7 +622,7 @@ void track(char move, Board *&game, bool over, bool &tied, bool &alt, int &T, in
     //print counter values
     cout << endl;
     cout << "Thomas: " << T << endl;
-    cout << "Hayden: " << H << endl;
+    cout << rival << ": " << H << endl;
     cout << "Draws: " << Tie << endl;
 }
 
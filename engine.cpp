@@ -0,0 +1,346 @@
+/*.cpp file for the Engine class, what Thomas and Hayden share: move generation for either color, 
+repetitions, endgame database probes and the choice among the best moves at the root. Each AI's search
+and evaluation are his own.*/
+
+#include <cstdlib>
+#include <string>
+#include <chrono>
+#include "board.h"
+#include "tablebase.h"
+#include "eval.h"
+#include "arena.h"
+#include "table.h"
+#include "engine.h"
+
+using namespace std;
+
+//constructor
+//parameters: a pointer to the AI's Evaluator, deleted with the Engine
+//returns: NA
+Engine::Engine(Evaluator *judge) {
+    state = new Board;
+    eval = judge;
+
+    //default, impossible values for AI's chosen move
+    row1 = 8;
+    col1 = 'I';
+    row2 = 8;
+    col2 = 'I';
+
+    diverge = false;
+    d_col = 'A', d_row = 0;
+
+    endgame = new Tablebase("db", TB_CACHE);
+    arena = new Arena;
+}
+
+//destructor
+//parameters: NA
+//returns: NA
+Engine::~Engine() {
+    delete state;
+    delete eval;
+    delete endgame;
+    delete arena;
+}
+
+//set_seed, seeds the random number generator used to choose between equally good moves
+//parameters: the seed
+//returns: void
+void Engine::set_seed(uint64_t seed) {
+    rng.seed(seed);
+}
+
+//update_AI, updates the board held by the AI to the game board
+//parameters: a Board to put in the copy constructor
+//returns: void
+void Engine::update_AI(const Board ref) {
+    delete state;
+    state = new Board(ref); //copy over board data
+}
+
+//set_history, sets the hashes of the game's positions since the last take or man move, so the search
+//can score a return to one of them as a draw
+//parameters: a ref to the hashes, ending with the position to move from
+//returns: void
+void Engine::set_history(const vector<uint64_t> &keys) {
+    played = keys;
+}
+
+//functions to get notation of decided move
+
+//get_row1, get row of first square of decided move
+//parameters: NA
+//returns: a char for the row
+char Engine::get_row1() {
+    return row1;
+}
+
+//get_col1, get col of first square of decided move
+//parameters: NA
+//returns: an int for the col
+int Engine::get_col1() {
+    return col1;
+}
+
+//get_row2, get row of second square of decided move
+//parameters: NA
+//returns: a char for the row
+char Engine::get_row2() {
+    return row2;
+}
+
+//get_col2, get col of first square of decided move
+//parameters: NA
+//returns: an int for the col
+int Engine::get_col2() {
+    return col2;
+}
+
+//generate, fills move arrays with coordinates, testing all possible movements for each piece of the 
+//color to move, given as the template parameter, forward and then, for kings, backward, with only 
+//takes once one is forced
+//parameters: a ref to a Board, a char array of column coordinates, an int array of row coordinates, and
+//a ref to the count integer
+//returns: void
+template <char TURN>
+void Engine::generate(Board &ref, char moves_c[], int moves_r[], int &count) {
+    char c1;
+    int r1;
+    const int ahead = (TURN == 'B') ? 1 : -1; //black moves down the board, white up
+    int num = (TURN == 'B') ? ref.get_num_black() : ref.get_num_white();
+    bool forced = ref.forced_take<TURN>(); //check for forced jump
+
+    for (int i = 0; i < num; i++) {
+        //iterate through each piece
+        c1 = ((TURN == 'B') ? ref.get_place_col_b(i) : ref.get_place_col_w(i)) + 'A';
+        r1 = (TURN == 'B') ? ref.get_place_row_b(i) : ref.get_place_row_w(i);
+        bool king = (TURN == 'B') ? ref.get_place_king_b(i) : ref.get_place_king_w(i);
+
+        for (int way = ahead; (way == ahead) || ((king) && (way == -ahead)); way -= 2 * ahead) {
+            if ((!forced) && (ref.simple_check<TURN>(c1, r1, c1 + 1, r1 + way))) {
+                moves_c[count * 2] = c1, moves_r[count * 2] = r1, moves_c[(count * 2) + 1] = c1 + 1, 
+                moves_r[(count * 2) + 1] = r1 + way;
+                count++;
+            } else if (ref.simple_check<TURN>(c1, r1, c1 + 2, r1 + (2 * way))) {
+                moves_c[count * 2] = c1, moves_r[count * 2] = r1, moves_c[(count * 2) + 1] = c1 + 2, 
+                moves_r[(count * 2) + 1] = r1 + (2 * way);
+                count++;
+            }
+            if ((!forced) && (ref.simple_check<TURN>(c1, r1, c1 - 1, r1 + way))) {
+                moves_c[count * 2] = c1, moves_r[count * 2] = r1, moves_c[(count * 2) + 1] = c1 - 1, 
+                moves_r[(count * 2) + 1] = r1 + way;
+                count++;
+            } else if (ref.simple_check<TURN>(c1, r1, c1 - 2, r1 + (2 * way))) {
+                moves_c[count * 2] = c1, moves_r[count * 2] = r1, moves_c[(count * 2) + 1] = c1 - 2, 
+                moves_r[(count * 2) + 1] = r1 + (2 * way);
+                count++;
+            }
+        }
+    }
+}
+
+//jumps_from, fills the position arrays similarly to generate, but only with jumps from one square, for 
+//when a piece of the color given as the template parameter has multiple options on a second or further
+//jump
+//parameters: a ref to a Board, a char and an int for the square, a char array of column coordinates, an
+//int array of row coordinates, and a ref to the count integer
+//returns: void
+template <char TURN>
+void Engine::jumps_from(Board &ref, char c1, int r1, char moves_c[], int moves_r[], int &count) {
+    //check all possible jumps from a single square
+    for (int dir = 0; dir < 4; dir++) {
+        char c2 = c1 + (((dir / 2) == 0) ? 2 : -2);
+        int r2 = r1 + (((dir % 2) == 0) ? 2 : -2);
+        if (ref.simple_check<TURN>(c1, r1, c2, r2)) {
+            moves_c[count * 2] = c1, moves_r[count * 2] = r1, moves_c[(count * 2) + 1] = c2, 
+            moves_r[(count * 2) + 1] = r2;
+            count++;
+        }
+    }
+}
+
+//fill_multi, helper function to multi, similar to jumps_from, but checks the jumps from a square of the 
+//held board as moves in the game
+//parameters: a char array of column coordinates, and int array of row coordinates, an int ref to  
+//count, a char and int for the particular square, a char for the color of the AI
+//returns: void
+void Engine::fill_multi(char moves_c[], int moves_r[], int &count, char c1, int r1, char color) {
+    for (int dir = 0; dir < 4; dir++) {
+        char c2 = c1 + (((dir / 2) == 0) ? 2 : -2);
+        int r2 = r1 + (((dir % 2) == 0) ? 2 : -2);
+        if (state->check_validity(c1, r1, c2, r2, color)) {
+            moves_c[count * 2] = c1, moves_r[count * 2] = r1, moves_c[(count * 2) + 1] = c2, 
+            moves_r[(count * 2) + 1] = r2;
+            count++;
+        }
+    }
+}
+
+//make_turn, makes a move from the move arrays on a board for the color given as the template parameter,
+//along with any further jumps the piece is forced to make, stopping where it has more than one way to
+//go on
+//parameters: a ref to the Board to make the move on, a char array of column coordinates, an int array 
+//of row coordinates, an int for the move's place in them and refs to chars and ints for four 
+//coordinate points, the move's first hop and the square its last hop landed on
+//returns: void
+template <char TURN>
+void Engine::make_turn(Board &next, char moves_c[], int moves_r[], int make, char &c1, char &c2, 
+char &c3, char &c4, int &r1, int &r2, int &r3, int &r4) {
+    c1 = moves_c[make * 2];
+    r1 = moves_r[make * 2];
+    c2 = moves_c[(make * 2) + 1];
+    r2 = moves_r[(make * 2) + 1];
+    c4 = c2, r4 = r2;
+
+    next.make_move(c1, r1, c2, r2); //make child move
+
+    //make another jump if a single one is possible, but if there are several, exit so move can be 
+    //evaluated with recursive diverge-type call
+    if (((abs(r2 - r1)) == 2) && (next.jump_possible<TURN>(c2, r2)) && (!next.kinged())) {
+        c3 = c2, r3 = r2;
+        while ((next.num_jumps(c3, r3) == 1) && (!next.kinged())) {
+            if (next.simple_check<TURN>(c3, r3, c3 + 2, r3 + 2)) {
+                c4 = c3 + 2, r4 = r3 + 2;
+            } else if (next.simple_check<TURN>(c3, r3, c3 + 2, r3 - 2)) {
+                c4 = c3 + 2, r4 = r3 - 2;
+            } else if (next.simple_check<TURN>(c3, r3, c3 - 2, r3 + 2)) {
+                c4 = c3 - 2, r4 = r3 + 2;
+            } else if (next.simple_check<TURN>(c3, r3, c3 - 2, r3 - 2)) {
+                c4 = c3 - 2, r4 = r3 - 2;
+            }
+            
+            next.make_move(c3, r3, c4, r4);
+            c3 = c4, r3 = r4;
+        }
+    }
+}
+
+//repeated, checks whether a position in the search has come up before, with the same color to move, 
+//either earlier on the line being searched or earlier in the game, and records it on the line
+//parameters: a ref to the Board, a char for the color to move, an int for its ply
+//returns: a bool for whether the position is a repetition, scored as a draw
+bool Engine::repeated(Board &ref, char turn, int ply) {
+    uint64_t key = ref.get_hash(turn);
+    line[ply] = key;
+
+    //positions on the line with the same color to move are an even number of turns back
+    for (int i = ply - 2; i >= 0; i -= 2) {
+        if (line[i] == key)
+            return true;
+    }
+
+    for (size_t i = 0; i < played.size(); i++) {
+        if (played[i] == key)
+            return true;
+    }
+
+    return false;
+}
+
+//probe, looks a position up in the endgame databases once few enough pieces are left. Won positions 
+//score below a win found by the search, less the distance to conversion and the number of pieces 
+//the loser has left, so the engine heads for the quickest conversion.
+//parameters: a ref to a Board, a char for the color to move, a char for the side to score it for
+//returns: an int for the score for the side, or NA if the databases don't cover the position
+int Engine::probe(Board &ref, char turn, char side) {
+    if (ref.get_num_black() + ref.get_num_white() > endgame->get_pieces())
+        return NA;
+
+    int dist;
+    uint8_t value = endgame->probe(Tablebase::convert(ref), turn == 'B', dist);
+    if (value == Tablebase::UNKNOWN) {
+        return NA;
+    } else if (value == Tablebase::DRAW) {
+        return 0;
+    }
+
+    //losing side's pieces, from the point of view of the side to move
+    int num_side = (side == 'B') ? ref.get_num_black() : ref.get_num_white();
+    int num_other = (side == 'B') ? ref.get_num_white() : ref.get_num_black();
+    int loser = ((value == Tablebase::WIN) != (turn == side)) ? num_side : num_other;
+    int score = TB_WIN - dist - (10 * loser);
+
+    return ((value == Tablebase::WIN) == (turn == side)) ? score : -score;
+}
+
+//hash_first, moves the best move stored for a position to the front of the move arrays
+//parameters: a pointer to the position's entry in the transposition table, NULL if it has none, a char
+//array of column coordinates, an int array of row coordinates, and an int for the number of moves
+//returns: an int for the number of moves put in front, 1 if the stored move was found, otherwise 0
+int Engine::hash_first(Mem_node *place, char moves_c[], int moves_r[], int count) {
+    if (place == NULL)
+        return 0;
+
+    for (int i = 0; i < count; i++) {
+        if ((moves_c[2 * i] == place->col1) && (moves_r[2 * i] == place->row1) && 
+        (moves_c[(2 * i) + 1] == place->col2) && (moves_r[(2 * i) + 1] == place->row2)) {
+            for (int j = i; j > 0; j--) {
+                swap(moves_c[2 * j], moves_c[2 * (j - 1)]);
+                swap(moves_c[(2 * j) + 1], moves_c[(2 * (j - 1)) + 1]);
+                swap(moves_r[2 * j], moves_r[2 * (j - 1)]);
+                swap(moves_r[(2 * j) + 1], moves_r[(2 * (j - 1)) + 1]);
+            }
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+//select, finds the optimal move once game-tree evaluations are completed, choosing randomly among the
+//best. With weigh set, a best move that brings the AI's kings closer to the opponent gets three 
+//chances, so an ending that's won makes progress.
+//parameters: a Node pointer, an int for the number of children, a char for the color of the AI, a bool
+//for whether to weigh by closeness, which needs the children's Boards
+//returns: an int for the array number of the chosen child
+int Engine::select(Node *start, int count, char color, bool weigh) {
+    int rando[150];
+    int num_same = 0; //number of possible moves with the same score
+    rando[0] = 0;
+
+    int max = NA;
+    for (int i = 0; i < count; i++) {
+        if (start->options[i].score > max) {
+            max = start->options[i].score;
+            num_same = 0;
+            rando[num_same] = i; //new highest's number added to first position in randomization array
+        } else if (start->options[i].score > max) {
+            num_same++;
+            rando[num_same] = i; //add later tied moves' child array number to randomization array
+        }
+
+        //if a highest scored move improves closeness, give it three positions in the randomization array
+        if ((weigh) && (start->options[i].score == max) && 
+        (eval->closeness(*start->options[i].position, color) < eval->closeness(*start->position, color))) {
+            num_same++;
+            rando[num_same] = i;
+            num_same++;
+            rando[num_same] = i;
+        }
+    }
+
+    //choose randomly among best moves, with extra weighting for ones that progress the game by 
+    //reducing closeness value
+    return rando[rng() % (num_same + 1)];
+}
+
+//clock_ms, gets the time from a clock that isn't changed by adjustments to the system time
+//parameters: NA
+//returns: a long long for the time in milliseconds
+long long Engine::clock_ms() {
+    chrono::steady_clock::duration now = chrono::steady_clock::now().time_since_epoch();
+    return chrono::duration_cast<chrono::milliseconds>(now).count();
+}
+
+//the colors the templated move generation is used for
+template void Engine::generate<'B'>(Board &ref, char moves_c[], int moves_r[], int &count);
+template void Engine::generate<'W'>(Board &ref, char moves_c[], int moves_r[], int &count);
+template void Engine::jumps_from<'B'>(Board &ref, char c1, int r1, char moves_c[], int moves_r[], 
+int &count);
+template void Engine::jumps_from<'W'>(Board &ref, char c1, int r1, char moves_c[], int moves_r[], 
+int &count);
+template void Engine::make_turn<'B'>(Board &next, char moves_c[], int moves_r[], int make, char &c1, 
+char &c2, char &c3, char &c4, int &r1, int &r2, int &r3, int &r4);
+template void Engine::make_turn<'W'>(Board &next, char moves_c[], int moves_r[], int make, char &c1, 
+char &c2, char &c3, char &c4, int &r1, int &r2, int &r3, int &r4);
@@ -0,0 +1,155 @@
+/*engine.h, the header file for the Engine class, the part of an AI that doesn't depend on which side it
+plays or how it searches: the board it decides from, its chosen move, move generation for either color,
+repetitions, the endgame databases and choosing among the best moves. Thomas and Hayden are both 
+Engines, each adding his own search, and plug in his own position scoring as an Evaluator.
+
+Moves are kept in pairs of entries in a column and a row array, the square moved from and the square 
+moved to, with columns as letters from 'A'.*/
+
+#include <string>
+#include <random>
+#include <vector>
+#include <chrono>
+#include <stdint.h>
+#include "board.h"
+#include "tablebase.h"
+#include "eval.h"
+#include "arena.h"
+#include "table.h"
+
+using namespace std;
+
+#ifndef ENGINE_H
+#define ENGINE_H
+
+class Engine {
+    protected:
+        //board held by AI to make decisions
+        Board *state;
+
+        //name of AI
+        string name;
+
+        //position scoring, for the side the AI plays
+        Evaluator *eval;
+
+        //random number generator for choosing between equal moves
+        mt19937_64 rng;
+
+        //position variables for chosen move
+        char col1, col2;
+        int row1, row2;
+
+        //restriction on possible moves for evaluating multiple jumps
+        bool diverge;
+
+        //hold piece position for divergent multiple jumps
+        char d_col;
+        int d_row;
+
+        //hashes of the game's positions that could still come up again, ending with the one to move 
+        //from, and of the positions on the line being searched, by ply
+        vector<uint64_t> played;
+        uint64_t line[100];
+
+        //endgame databases, probed once few enough pieces are left
+        Tablebase *endgame;
+
+        //memory the search tree is made from, reset at the start of each decision
+        Arena *arena;
+
+        //Game tree node
+        struct Node {
+            Board *position;
+            Node *options;
+            int score;
+            char row1, row2;
+            char col1, col2;
+        };
+
+        //board size constant
+        const static int DIMEN = 8;
+
+        //piece constants
+        const static char WHITE_PIECE = 'r', WHITE_KING = 'R';
+        const static char BLACK_PIECE = 'b', BLACK_KING = 'B';
+        const static char BLANK = ' ', BLACK_SQUARE = '-';
+
+        //score for a position not found in the endgame databases
+        const static int NA = -32000;
+
+        //base score for a position the endgame databases show as won, below the scores for a win
+        //found by the search
+        const static int TB_WIN = 9000;
+
+        //number of decoded database blocks to keep cached
+        const static int TB_CACHE = 2048;
+
+        //fill the move arrays with every move for a color, only takes if one is forced
+        template <char TURN>
+        void generate(Board &ref, char moves_c[], int moves_r[], int &count);
+
+        //fill the move arrays with the jumps from one square, for a multiple jump going on
+        template <char TURN>
+        void jumps_from(Board &ref, char c1, int r1, char moves_c[], int moves_r[], int &count);
+
+        //fill the move option arrays from only one starting square of the held board
+        void fill_multi(char moves_c[], int moves_r[], int &count, char c1, int r1, char color);
+
+        //make a move from the move arrays on a board, along with any jumps the piece is then forced 
+        //to make
+        template <char TURN>
+        void make_turn(Board &next, char moves_c[], int moves_r[], int make, char &c1, char &c2, 
+        char &c3, char &c4, int &r1, int &r2, int &r3, int &r4);
+
+        //checks whether a position in the search has come up before on the line or in the game
+        bool repeated(Board &ref, char turn, int ply);
+
+        //look up a position in the endgame databases, for a side, returns NA if it isn't covered
+        int probe(Board &ref, char turn, char side);
+
+        //move the stored best move for a position to the front of the move arrays, returns 1 if found
+        int hash_first(Mem_node *place, char moves_c[], int moves_r[], int count);
+
+        //chooses among the best scored moves at the root
+        int select(Node *start, int count, char color, bool weigh);
+
+        //gets the time from a steady clock, in milliseconds
+        static long long clock_ms();
+
+    public:
+        //constructor, with the AI's position scoring, which the Engine then owns
+        Engine(Evaluator *judge);
+
+        //destructor
+        virtual ~Engine();
+
+        //seed the random number generator, so games can be replayed
+        void set_seed(uint64_t seed);
+
+        //updates the board held by the AI to the game board
+        virtual void update_AI(const Board ref);
+
+        //set the hashes of the game's positions that could still be repeated, ending with the current one
+        virtual void set_history(const vector<uint64_t> &keys);
+
+        //get the AI's name
+        string get_name() {
+            return name;
+        }
+
+        //functions to get notation of decided move
+        //get row of first square
+        char get_row1();
+
+        //get column of first square
+        int get_col1();
+
+        //get row of second square
+        char get_row2();
+
+        //get column of second square
+        int get_col2();
+};
+
+#endif
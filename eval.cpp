@@ -0,0 +1,412 @@
+/*.cpp file for the Evaluator classes, Thomas's and Hayden's position scoring. Thomas values pieces
+by how far they've advanced and how well they're backed up, and a material lead more heavily the fewer
+pieces are left. Hayden keeps his kings central and his men on the edges, and values a lead less.*/
+
+#include <cstdlib>
+#include "board.h"
+#include "eval.h"
+
+using namespace std;
+
+//calc, evaluates the positional score of a leaf Node position
+//parameters: a ref to a Board object
+//returns: and integer for the position's score
+int Thomas_eval::calc(Board &ref) {
+    //piece scores
+    int black = 0, white = 0;
+    char num_b = ref.get_num_black(), num_w = ref.get_num_white(), R, C;
+
+    //(incomplete) check for win or loss based on number of pieces
+    if (num_w == 0) {
+        return 9900;
+    } else if (num_b == 0) {
+        return -9900;
+    }
+
+    //iterate through the white pieces, giving each a value based on its type and locations
+    for (int i = 0; i < num_w; i++) {
+        R = ref.get_place_row_w(i);
+        C = ref.get_place_col_w(i);
+
+        //kings are worth about 1.5 times as much as regular pieces, and more if close to oppossing 
+        //pieces if the player is ahead in pieces
+        //iterate through white pieces
+        if (ref.get_place_king_w(i)) {
+            if (num_w > num_b) {
+                white += 336 - (3 * proximity(R, C, 'W', ref, num_b, num_w));
+            } else {
+                white += 336 - (1 * proximity(R, C, 'W', ref, num_b, num_w));
+            }
+
+            if (((R == 2) && (ref.look(R - 2, C) == BLACK_KING)) || ((R == 5) && 
+            (ref.look(R + 2, C) == BLACK_KING)) || ((C == 2) && (ref.look(R, C - 2) == BLACK_KING)) ||
+            ((C == 5) && (ref.look(R, C + 2) == BLACK_KING))) {
+                white += 20;
+            }
+            
+        } else {
+            white += 214 - 2 * R;
+
+            if ((C == 0) || (C == DIMEN_LESS1))
+                white += 4;
+
+            if (((R < DIMEN_LESS1) && (C > 0) && (ref.look(R + 1, C - 1) == WHITE_PIECE)) || 
+            ((R < DIMEN_LESS1) && (C < DIMEN_LESS1) && ref.look(R + 1, C + 1) == WHITE_PIECE))
+                white += 4;
+        }
+    }
+
+    //iterate through black pieces
+    for (int i = 0; i < num_b; i++) {
+        R = ref.get_place_row_b(i);
+        C = ref.get_place_col_b(i);
+
+        if (ref.get_place_king_b(i)) {
+            if (num_b > num_w) {
+                black += 336 - (3 * proximity(R, C, 'B', ref, num_b, num_w));
+            } else {
+                black += 336 - (1 * proximity(R, C, 'B', ref, num_b, num_w));
+            }
+
+            if (((R == 2) && (ref.look(R - 2, C) == WHITE_KING)) || ((R == 5) && 
+            (ref.look(R + 2, C) == WHITE_KING)) || ((C == 2) && (ref.look(R, C - 2) == WHITE_KING)) ||
+            ((C == 5) && (ref.look(R, C + 2) == WHITE_KING))) {
+                black += 20;
+            }
+
+        } else {
+            black += 193 + 2 * R;
+
+            if ((C == 0) || (C == DIMEN_LESS1))
+                black += 4;
+
+            if (((R > 0) && (C < DIMEN_LESS1) && (ref.look(R - 1, C + 1) == BLACK_PIECE)) || 
+            ((R > 0) && (C > 0) && ref.look(R - 1, C - 1) == BLACK_PIECE))
+                black += 4;
+        }
+    }
+
+    //if there is a single piece of a color, assign value to its being in a double corner or close to center
+    if ((num_b == 1) && (num_w > 1)) {
+        if ((ref.look(6, 7) == BLACK_KING) || (ref.look(7, 6) == BLACK_KING) || 
+        (ref.look(0, 1) == BLACK_KING) || (ref.look(1, 0) == BLACK_KING) ||
+        (ref.look(6, 5) == BLACK_KING) || (ref.look(5, 6) == BLACK_KING) ||
+        (ref.look(1, 2) == BLACK_KING) || (ref.look(2, 1) == BLACK_KING))
+            black += 50;
+    } else if ((num_w == 1) && (num_b > 1)) {
+        if ((ref.look(6, 7) == WHITE_KING) || (ref.look(7, 6) == WHITE_KING) || 
+        (ref.look(0, 1) == WHITE_KING) || (ref.look(1, 0) == WHITE_KING) || 
+        (ref.look(6, 5) == WHITE_KING) || (ref.look(5, 6) == WHITE_KING) ||
+        (ref.look(1, 2) == WHITE_KING) || (ref.look(2, 1) == WHITE_KING))
+            white += 50;
+    }
+
+    //value trapping an opposing king in a single square corner
+    if ((ref.look(0, 7) == WHITE_KING) && (ref.look(2, 5) == BLACK_KING)) {
+        black += 25;
+    } else if ((ref.look(0, 7) == BLACK_KING) && (ref.look(2, 5) == WHITE_KING)) {
+        white += 25;
+    }
+
+    if ((ref.look(7, 0) == WHITE_KING) && (ref.look(5, 2) == BLACK_KING)) {
+        black += 25;
+    } else if ((ref.look(7, 0) == BLACK_KING) && (ref.look(5, 2) == WHITE_KING)) {
+        white += 25;
+    }
+
+    //value of having more pieces increases exponentially with declining number of pieces
+    if (num_w > num_b) {
+        int temp = (num_w - num_b) * (17 - num_b) * (17 - num_b);
+
+        if (temp < 5000) {
+            white += temp;
+        } else {
+            white += 5000; //avoid value here higher than winning value
+        }
+    } else if (num_b > num_w) {
+        int temp = (num_b - num_w) * (17 - num_w) * (17 - num_w);
+
+        if (temp < 5000) {
+            black += temp;
+        } else {
+            black += 5000; //avoid value here higher than winning value
+        }
+    }
+    
+    return (black - white);
+}
+
+//proximity, finds how close a piece is to the nearest opposing king
+//parameters: an int for the piece's row, an int for its column, a string for the color of the piece, a ref 
+//to a Board object to scan, ints for the numbers of black and white pieces
+//returns: an int for the distance to the nearest opposing king
+int Thomas_eval::proximity(int row, int column, char turn, Board &ref, int num_b, int num_w) {
+    int dist = 5, x = 0, y = 0;
+
+    if (turn == 'W') {
+        for (int i = 0; i < num_b; i++) {
+        if (ref.get_place_king_b(i)) {
+                x = abs(ref.get_place_col_b(i) - column);
+                y = abs(ref.get_place_row_b(i) - row);
+    
+                if ((x < dist) && (y < dist)) {
+                    if (x > y) {
+                        dist = x;
+                    } else {
+                        dist = y;
+                    }
+                }  
+            }
+        }
+    } else {
+        for (int i = 0; i < num_w; i++) {
+            if (ref.get_place_king_w(i)) {
+                x = abs(ref.get_place_col_w(i) - column);
+                y = abs(ref.get_place_row_w(i) - row);
+
+                if ((x < dist) && (y < dist)) {
+                    if (x > y) {
+                        dist = x;
+                    } else {
+                        dist = y;
+                    }
+                }
+            }
+        }
+    }
+
+    return dist; //dist is smaller of column difference and row difference
+}
+
+//closeness, finds the average distance between the kings of the selected color and the nearest 
+//opposing king
+//parameters: a ref to a Board, and a string for the color of the kings to measure distance of nearest
+//opponent from
+//returns: a double for the average king minimum distance
+double Thomas_eval::closeness(Board &ref, char color) {
+    double total = 0; //sum of distances
+    double kings = 0;
+    int num_b = ref.get_num_black(), num_w = ref.get_num_white();
+
+    bool hold = false;
+    if (ref.look(0, 0) == BLANK)
+        hold = true;
+    for (int i = 0; i < DIMEN; i++) {
+        for (int j = hold; j < DIMEN; j += 2) {
+            if ((color == 'W') && (ref.look(i, j) == WHITE_KING)) {
+                if (proximity(i, j, 'W', ref, num_b, num_w) > 2)
+                    total += proximity(i, j, 'W', ref, num_b, num_w);
+                kings++;
+            } else if ((color == 'B') && (ref.look(i, j) == BLACK_KING)) {
+                if (proximity(i, j, 'B', ref, num_b, num_w) > 2)
+                    total += proximity(i, j, 'B', ref, num_b, num_w);
+                kings++;
+            }
+        }
+        hold = (!hold);
+    }
+    
+    return (total/kings);
+}
+
+//calc, evaluates the positional score of a leaf Node position
+//parameters: a ref to a Board object
+//returns: and integer for the position's score
+int Hayden_eval::calc(Board &ref) {
+    //piece scores
+    int black = 0, white = 0, R, C;
+    int num_b = ref.get_num_black(), num_w = ref.get_num_white();
+
+    //(incomplete) check for win or loss based on number of pieces
+    if (num_b == 0) {
+        return 9995;
+    } else if (num_w == 0) {
+        return -9994;
+    }
+
+    //interate through the white pieces, giving each a value based on its type and locations
+    for (int i = 0; i < num_w; i++) {
+        R = ref.get_place_row_w(i);
+        C = ref.get_place_col_w(i);
+
+        //kings are worth about 1.5 times as much as regular pieces, and more if close to oppossing 
+        //pieces if the player is ahead in pieces
+        //iterate through white pieces
+        if (ref.get_place_king_w(i)) {
+            if (num_w > num_b) {
+                white += 336 - (3 * proximity(R, C, 'W', ref, num_b, num_w));
+            } else {
+                white += 336 - (1 * proximity(R, C, 'W', ref, num_b, num_w));
+            }
+
+            if (((R == 2) && (ref.look(R - 2, C) == BLACK_KING)) || ((R == 5) && 
+            (ref.look(R + 2, C) == BLACK_KING)) || ((C == 2) && (ref.look(R, C - 2) == BLACK_KING)) ||
+            ((C == 5) && (ref.look(R, C + 2) == BLACK_KING))) {
+                white += 8;
+            }
+
+            white -= 4 * (abs(4 - R) + abs(4 - C));
+        } else {
+            white += 207 - R;
+
+            if ((C == 0) || (C == DIMEN - 1)) {
+                white += 10;
+            }
+        }
+    }
+
+    //interate through black pieces
+    for (int i = 0; i < num_b; i++) {
+        R = ref.get_place_row_b(i);
+        C = ref.get_place_col_b(i);
+
+        if (ref.get_place_king_b(i)) {
+            if (num_b > num_w) {
+                black += 336 - (3 * proximity(R, C, 'B', ref, num_b, num_w));
+            } else {
+                black += 336 - (1 * proximity(R, C, 'B', ref, num_b, num_w));
+            }
+
+            if (((R == 2) && (ref.look(R - 2, C) == WHITE_KING)) || ((R == 5) && 
+            (ref.look(R + 2, C) == WHITE_KING)) || ((C == 2) && (ref.look(R, C - 2) == WHITE_KING)) ||
+            ((C == 5) && (ref.look(R, C + 2) == WHITE_KING))) {
+                black += 8;
+            }
+
+            black -= 4 * (abs(4 - R) + abs(4 - C));
+        } else {
+            black += 200 + R;
+
+            if ((C == 0) || (C == DIMEN - 1)) {
+                black += 10;
+            }
+        }
+    }
+
+    //if there is a single piece of a color, assign value to its being in a double corner or close to center
+    if ((num_b == 1) && (num_w > 1)) {
+        black += 6 * (abs(4 - ref.get_place_col(0, 'B')) + abs(4 - ref.get_place_row(0, 'B')));
+        if ((ref.look(6, 7) == BLACK_KING) || (ref.look(7, 6) == BLACK_KING) || 
+        (ref.look(0, 1) == BLACK_KING) || (ref.look(1, 0) == BLACK_KING) ||
+        (ref.look(6, 5) == BLACK_KING) || (ref.look(5, 6) == BLACK_KING) ||
+        (ref.look(1, 2) == BLACK_KING) || (ref.look(2, 1) == BLACK_KING))
+            black += 50;
+    } else if ((num_w == 1) && (num_b > 1)) {
+        white += 6 * (abs(4 - ref.get_place_col(0, 'W')) + abs(4 - ref.get_place_row(0, 'W')));
+        if ((ref.look(6, 7) == WHITE_KING) || (ref.look(7, 6) == WHITE_KING) || 
+        (ref.look(0, 1) == WHITE_KING) || (ref.look(1, 0) == WHITE_KING) || 
+        (ref.look(6, 5) == WHITE_KING) || (ref.look(5, 6) == WHITE_KING) ||
+        (ref.look(1, 2) == WHITE_KING) || (ref.look(2, 1) == WHITE_KING))
+            white += 50;
+    }
+
+    //value trapping an opposing king in a single square corner
+    if ((ref.look(0, 7) == WHITE_KING) && (ref.look(2, 5) == BLACK_KING)) {
+        black += 10;
+    } else if ((ref.look(0, 7) == BLACK_KING) && (ref.look(2, 5) == WHITE_KING)) {
+        white += 10;
+    }
+
+    if ((ref.look(7, 0) == WHITE_KING) && (ref.look(5, 2) == BLACK_KING)) {
+        black += 10;
+    } else if ((ref.look(7, 0) == BLACK_KING) && (ref.look(5, 2) == WHITE_KING)) {
+        white += 10;
+    }
+
+    //value of having more pieces increases exponentially with declining number of pieces
+    if (num_w > num_b) {
+        int temp = ((num_w - num_b) * 12) - num_b;
+        temp = temp * temp;
+
+        if (temp < 500) {
+            white += temp;
+        } else {
+            white += 500; //avoid value here higher than winning value
+        }
+    } else if (num_b > num_w) {
+        int temp = ((num_b - num_w) * 12) - num_w;
+        temp = temp * temp;
+
+        if (temp < 500) {
+            black += temp;
+        } else {
+            black += 500; //avoid value here higher than winning value
+        }
+    }
+
+    
+    return (white - black); //score is difference in value of white and black positions
+}
+
+//proximity, finds how close a piece is to the nearest opposing piece
+//parameters: an int for the piece's row, an int for its column, a string for the color of the piece, a ref 
+//to a Board object to scan, ints for the numbers of black and white pieces
+//returns: a short for the distance to the nearest opposing piece
+short Hayden_eval::proximity(int row, int column, char turn, Board &ref, int num_b, int num_w) {
+    short dist = 7, x = 0, y = 0;
+
+    if (turn == 'W') {
+        for (int i = 0; i < num_b; i++) {
+            x = abs(ref.get_place_col_b(i) - column);
+            y = abs(ref.get_place_row_b(i) - row);
+
+            if ((x < dist) && (y < dist)) {
+                if (x > y) {
+                    dist = x;
+                } else {
+                    dist = y;
+                }
+
+                if (dist == 1)
+                    return 1; //save time if adjacent
+            }  
+        }
+    } else {
+        for (short i = 0; i < num_w; i++) {
+            x = abs(ref.get_place_col_w(i) - column);
+            y = abs(ref.get_place_row_w(i) - row);
+
+            if ((x < dist) && (y < dist)) {
+                if (x > y) {
+                    dist = x;
+                } else {
+                    dist = y;
+                }
+
+                if (dist == 1)
+                    return 1; //save time if adjacent
+            }
+        }
+    }
+
+    return dist; //dist is smaller of column difference and row difference
+}
+
+//closeness, finds the average distance between the kings of the selected color and the nearest 
+//opposing piece
+//parameters: a ref to a Board, and a string for the color of the kings to measure distance of nearest
+//opponent from
+//returns: a double for the average king minimum distance
+double Hayden_eval::closeness(Board &ref, char color) {
+    double total = 0; //sum of distances
+    double kings = 0;
+    int num_b = ref.get_num_black(), num_w = ref.get_num_white();
+
+    bool hold = false;
+    if (ref.look(0, 0) == BLANK)
+        hold = true;
+    for (int i = 0; i < DIMEN; i++) {
+        for (int j = hold; j < DIMEN; j += 2) {
+            if ((color == 'W') && (ref.look(i, j) == WHITE_KING)) {
+                total += proximity(i, j, 'W', ref, num_b, num_w);
+                kings++;
+            } else if ((color == 'B') && (ref.look(i, j) == BLACK_KING)) {
+                total += proximity(i, j, 'B', ref, num_b, num_w);
+                kings++;
+            }
+        }
+        hold = (!hold);
+    }
+    
+    return (total/kings);
+}
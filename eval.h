@@ -0,0 +1,61 @@
+/*eval.h, the header file for the Evaluator classes, the position scoring plugged into the engine. Each
+AI brings its own: Thomas's scores positions for black and Hayden's for white, and they weigh pieces,
+kings and the endgame differently.
+
+closeness is part of the evaluation too, since the two measure how far a king is from the opponent
+differently, Thomas from the nearest opposing king and Hayden from the nearest opposing piece.*/
+
+#include "board.h"
+
+using namespace std;
+
+#ifndef EVAL_H
+#define EVAL_H
+
+class Evaluator {
+    protected:
+        //board size constants
+        const static int DIMEN = 8;
+        const static int DIMEN_LESS1 = 7;
+
+        //piece constants
+        const static char WHITE_PIECE = 'r', WHITE_KING = 'R';
+        const static char BLACK_PIECE = 'b', BLACK_KING = 'B';
+        const static char BLANK = ' ', BLACK_SQUARE = '-';
+
+    public:
+        //destructor
+        virtual ~Evaluator() {}
+
+        //evaluates how favorable a position is to the side the evaluator plays for
+        virtual int calc(Board &ref) = 0;
+
+        //finds the average distance between the kings of a given color and the nearest opponent
+        virtual double closeness(Board &ref, char color) = 0;
+};
+
+//Thomas's evaluation, for black
+class Thomas_eval : public Evaluator {
+    private:
+        //calculates the distance of a piece from the nearest opposing king
+        int proximity(int row, int column, char turn, Board &ref, int num_b, int num_w);
+
+    public:
+        int calc(Board &ref);
+
+        double closeness(Board &ref, char color);
+};
+
+//Hayden's evaluation, for white
+class Hayden_eval : public Evaluator {
+    private:
+        //calculates the distance of a piece from the nearest opposing piece
+        short proximity(int row, int column, char turn, Board &ref, int num_b, int num_w);
+
+    public:
+        int calc(Board &ref);
+
+        double closeness(Board &ref, char color);
+};
+
+#endif
@@ -0,0 +1,100 @@
+/*.cpp file for the Move_order class, the killer moves and history scores shared by both AIs for
+ordering their moves. Depths are the depth left below a node, so a killer found at one node is tried
+at its cousins, which have the same depth left however the search got to them.*/
+
+#include <cstring>
+#include "order.h"
+
+using namespace std;
+
+const int Move_order::MAX_DEPTH;
+
+//constructor, starts with no killers and no history
+//parameters: NA
+//returns: NA
+Move_order::Move_order() {
+    memset(history, 0, sizeof(history));
+    age();
+}
+
+//age, halves the history scores, so the moves that did well on the last move still come first without
+//outweighing what's learned on this one, and forgets the killers, which were found from a root that's
+//changed
+//parameters: NA
+//returns: void
+void Move_order::age() {
+    for (int i = 0; i < MAX_DEPTH; i++) {
+        killer_c[2 * i] = killer_c[(2 * i) + 1] = DIMEN + 'A';
+        killer_r[2 * i] = killer_r[(2 * i) + 1] = DIMEN;
+        for (int j = 0; j < 64; j++) {
+            for (int k = 0; k < 64; k++) {
+                history[i][j][k] >>= 1;
+            }
+        }
+    }
+}
+
+//cutoff, makes a move that caused a cutoff the killer at its depth, and adds to its history score if
+//there was enough depth left below it to mean something
+//parameters: chars and ints for the move's columns and rows, an int for the depth left
+//returns: void
+void Move_order::cutoff(char c1, int r1, char c2, int r2, int depth) {
+    if ((depth < 0) || (depth >= MAX_DEPTH))
+        return;
+
+    killer_c[2 * depth] = c1, killer_c[(2 * depth) + 1] = c2;
+    killer_r[2 * depth] = r1, killer_r[(2 * depth) + 1] = r2;
+
+    if (depth > 1)
+        history[depth][(r1 * DIMEN) + (c1 - 'A')][(r2 * DIMEN) + (c2 - 'A')]++;
+}
+
+//is_killer, checks whether a move is the killer at a depth
+//parameters: chars and ints for the move's columns and rows, an int for the depth left
+//returns: a bool for whether it's the killer
+bool Move_order::is_killer(char c1, int r1, char c2, int r2, int depth) {
+    if ((depth < 0) || (depth >= MAX_DEPTH))
+        return false;
+
+    return (killer_c[2 * depth] == c1) && (killer_r[2 * depth] == r1) &&
+    (killer_c[(2 * depth) + 1] == c2) && (killer_r[(2 * depth) + 1] == r2);
+}
+
+//order, puts the killer first among the moves from a given place on, if it's there, and sorts the
+//rest by history score, highest first, keeping moves with the same score in the order they came in
+//parameters: a char array of column coordinates, an int array of row coordinates, ints for the number
+//of moves, the depth left and the first move to order, the ones before it staying where they are
+//returns: void
+void Move_order::order(char moves_c[], int moves_r[], int count, int depth, int first) {
+    if ((depth < 0) || (depth >= MAX_DEPTH))
+        return;
+
+    for (int i = count - 1; i >= first; i--) {
+        if (is_killer(moves_c[2 * i], moves_r[2 * i], moves_c[(2 * i) + 1], moves_r[(2 * i) + 1],
+        depth)) {
+            swap_moves(moves_c, moves_r, i, first);
+            first++;
+            break;
+        }
+    }
+
+    for (int i = first + 1; i < count; i++) {
+        for (int j = i; (j > first) && (score(moves_c, moves_r, j, depth) >
+        score(moves_c, moves_r, j - 1, depth)); j--)
+            swap_moves(moves_c, moves_r, j, j - 1);
+    }
+}
+
+//swap_moves, swaps two moves in the move arrays
+//parameters: a char array of column coordinates, an int array of row coordinates, ints for the
+//places of the two moves
+//returns: void
+void Move_order::swap_moves(char moves_c[], int moves_r[], int i, int j) {
+    char tempc1 = moves_c[2 * i], tempc2 = moves_c[(2 * i) + 1];
+    int tempr1 = moves_r[2 * i], tempr2 = moves_r[(2 * i) + 1];
+
+    moves_c[2 * i] = moves_c[2 * j], moves_c[(2 * i) + 1] = moves_c[(2 * j) + 1];
+    moves_r[2 * i] = moves_r[2 * j], moves_r[(2 * i) + 1] = moves_r[(2 * j) + 1];
+    moves_c[2 * j] = tempc1, moves_c[(2 * j) + 1] = tempc2;
+    moves_r[2 * j] = tempr1, moves_r[(2 * j) + 1] = tempr2;
+}
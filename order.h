@@ -0,0 +1,58 @@
+/*order.h, the header file for the Move_order class, the killer moves and history scores both AIs order
+their moves by. A move that caused a cutoff is tried first the next time a position at the same depth
+left comes up, and the rest follow by how often each move has caused a cutoff at that depth.
+
+Moves are kept as the AIs keep them, in pairs of entries in a column and a row array, the square moved
+from and the square moved to.*/
+
+#include <stdint.h>
+
+using namespace std;
+
+#ifndef ORDER_H
+#define ORDER_H
+
+class Move_order {
+    private:
+        /***Constants***/
+
+        //deepest search ordered, by depth left
+        const static int MAX_DEPTH = 64;
+
+        //board size constant
+        const static int DIMEN = 8;
+
+        //last move to cause a cutoff at each depth left
+        char killer_c[2 * MAX_DEPTH];
+        int killer_r[2 * MAX_DEPTH];
+
+        //number of cutoffs each move has caused at each depth left, by the squares moved from and to
+        int history[MAX_DEPTH][64][64];
+
+        //swap two moves in the arrays
+        void swap_moves(char moves_c[], int moves_r[], int i, int j);
+
+        //get a move's history score
+        int score(char moves_c[], int moves_r[], int i, int depth) {
+            return history[depth][(moves_r[2 * i] * DIMEN) + (moves_c[2 * i] - 'A')]
+            [(moves_r[(2 * i) + 1] * DIMEN) + (moves_c[(2 * i) + 1] - 'A')];
+        }
+
+    public:
+        //constructor, with no killers and no history
+        Move_order();
+
+        //halve the history scores and forget the killers, at the start of a move
+        void age();
+
+        //record a move that caused a cutoff with a given depth left
+        void cutoff(char c1, int r1, char c2, int r2, int depth);
+
+        //whether a move is the killer at a given depth left
+        bool is_killer(char c1, int r1, char c2, int r2, int depth);
+
+        //order moves from a given place in the arrays on, the killer first and then by history
+        void order(char moves_c[], int moves_r[], int count, int depth, int first);
+};
+
+#endif
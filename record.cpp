@@ -0,0 +1,331 @@
+/*.cpp file for the Record class, the game record, and its file writer and reader. Turns are recorded
+by the position they lead to, rather than by the moves the players entered, so moves made anywhere,
+including the player's multiple jumps made inside the Board, are recorded the same way. The hops of
+a turn are found by searching the legal hops from the last recorded position for the one that
+matches, which is cheap, since a position rarely has more than a handful of legal moves.*/
+
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "record.h"
+
+using namespace std;
+
+const uint16_t Record::MAGIC;
+const uint8_t Record::VERSION;
+const uint16_t Record::AGAIN;
+const uint8_t Record::REVERSED, Record::WHITE_FIRST;
+
+//the pieces, by the number they're stored as in a record file
+static const char PIECES[] = "-bBrR";
+
+//constructor, starts a record from the standard starting position with black to move
+//parameters: NA
+//returns: NA
+Record::Record() {
+    first = 'B', turn = 'B';
+    add_key(false);
+}
+
+//constructor, starts a record from a given position
+//parameters: a ref to the starting position, a char for the color to move
+//returns: NA
+Record::Record(const Board &ref, char color) : start(ref), last(ref) {
+    first = color, turn = color;
+    add_key(false);
+}
+
+//add_key, records the hash of the last position with the color to move
+//parameters: a bool for whether the turn leading to it can be undone by the other moves of the game
+//returns: void
+void Record::add_key(bool reversible) {
+    keys.push_back(last.get_hash(turn));
+    quiet.push_back(((reversible) && (!quiet.empty())) ? quiet.back() + 1 : 0);
+}
+
+//pack, packs a hop into two bytes, with squares numbered as in the hashing key
+//parameters: ints for the first column and row, and the second column and row, and a bool for
+//whether the hop continues a turn
+//returns: the packed hop
+uint16_t Record::pack(int col1, int row1, int col2, int row2, bool again) {
+    uint16_t hop = (((row1 * 8) + col1) / 2) | ((((row2 * 8) + col2) / 2) << 5);
+    if (again)
+        hop |= AGAIN;
+    return hop;
+}
+
+//unpack, unpacks a hop into notation for make_move
+//parameters: a packed hop, a bool for the reversed orientation, refs to the columns and rows to fill
+//returns: void
+void Record::unpack(uint16_t hop, bool reversed, char &col1, int &row1, char &col2, int &row2) {
+    int s1 = hop & 0x1F, s2 = (hop >> 5) & 0x1F;
+    row1 = s1 / 4, row2 = s2 / 4;
+    col1 = 'A' + (2 * (s1 % 4)) + ((((row1 % 2) == 0) != reversed) ? 1 : 0);
+    col2 = 'A' + (2 * (s2 % 4)) + ((((row2 % 2) == 0) != reversed) ? 1 : 0);
+}
+
+//add_turn, records the turn leading from the last recorded position to a new one
+//parameters: a ref to the position after the turn
+//returns: a bool for whether a legal turn was found, the record is unchanged if not
+bool Record::add_turn(Board &after) {
+    size_t before = hops.size();
+
+    if (!find_hops(last, after, turn, 0, 0, false)) {
+        hops.resize(before);
+        return false;
+    }
+
+    //only a king moving without taking can come back to the same square
+    char col1, col2;
+    int row1, row2;
+    unpack(hops[before], (start.look(0, 0) != ' '), col1, row1, col2, row2);
+    char piece = last.look(row1, col1 - 'A');
+    bool reversible = (abs(row2 - row1) == 1) && ((piece == 'B') || (piece == 'R'));
+
+    turn_start.push_back(before);
+    last = after;
+    turn = (turn == 'B') ? 'W' : 'B';
+    add_key(reversible);
+
+    return true;
+}
+
+//find_hops, recursive helper to add_turn, tries every legal hop and follows multiple jumps until
+//the position matches, leaving the hops that led there on the end of the record
+//parameters: a ref to the position to hop from, a ref to the position to reach, a char for the color
+//moving, ints for the column and row of the jumping piece and a bool for whether a jump is being
+//continued, in which case only that piece may hop
+//returns: a bool for whether the position was reached
+bool Record::find_hops(Board &ref, Board &after, char color, int col, int row, bool again) {
+    for (int row1 = 0; row1 < 8; row1++) {
+        for (int col1 = 0; col1 < 8; col1++) {
+            if ((again) && ((row1 != row) || (col1 != col)))
+                continue;
+
+            char piece = ref.look(row1, col1);
+            if ((color == 'B') ? ((piece != 'b') && (piece != 'B')) : ((piece != 'r') && (piece != 'R')))
+                continue;
+
+            for (int dist = (again ? 2 : 1); dist <= 2; dist++) {
+                for (int dir = 0; dir < 4; dir++) {
+                    int row2 = row1 + (((dir / 2) == 0) ? -dist : dist);
+                    int col2 = col1 + (((dir % 2) == 0) ? -dist : dist);
+
+                    if (!ref.check_validity('A' + col1, row1, 'A' + col2, row2, color))
+                        continue;
+
+                    Board next(ref);
+                    next.make_move('A' + col1, row1, 'A' + col2, row2);
+                    hops.push_back(pack(col1, row1, col2, row2, again));
+
+                    if ((dist == 2) && (next.jump_possible('A' + col2, row2, color)) && (!next.kinged())) {
+                        if (find_hops(next, after, color, col2, row2, true))
+                            return true;
+                    } else if ((next.get_hash(color) == after.get_hash(color)) && (next.same(after))) {
+                        return true;
+                    }
+
+                    hops.pop_back();
+                }
+            }
+        }
+    }
+
+    return false;
+}
+
+//get_history, gets the hashes of the positions that could still be repeated, those since the last
+//take or move by a man, for the engines to check their searches against
+//parameters: NA
+//returns: a vector of hashes, ending with the current position
+vector<uint64_t> Record::get_history() {
+    return vector<uint64_t>(keys.end() - quiet.back() - 1, keys.end());
+}
+
+//repetitions, counts the times the current position has come up with the same color to move
+//parameters: NA
+//returns: an int for the number of times, at least 1
+int Record::repetitions() {
+    int times = 0;
+    for (size_t i = keys.size() - quiet.back() - 1; i < keys.size(); i++) {
+        if (keys[i] == keys.back())
+            times++;
+    }
+
+    return times;
+}
+
+//position, rebuilds the position after a number of turns by replaying the record
+//parameters: an int for the number of turns
+//returns: the Board after that many turns
+Board Record::position(int turns) {
+    if (turns >= (int) turn_start.size())
+        return last;
+
+    Board ref(start);
+    bool reversed = (start.look(0, 0) != ' ');
+    size_t end = (turns < 0) ? 0 : turn_start[turns];
+    for (size_t i = 0; i < end; i++) {
+        char col1, col2;
+        int row1, row2;
+        unpack(hops[i], reversed, col1, row1, col2, row2);
+        ref.make_move(col1, row1, col2, row2);
+    }
+
+    return ref;
+}
+
+//truncate, drops every turn after a number of turns
+//parameters: an int for the number of turns to keep
+//returns: void
+void Record::truncate(int turns) {
+    if ((turns < 0) || (turns >= (int) turn_start.size()))
+        return;
+
+    last = position(turns);
+    hops.resize(turn_start[turns]);
+    turn_start.resize(turns);
+    keys.resize(turns + 1);
+    quiet.resize(turns + 1);
+    turn = ((turns % 2) == 0) ? first : ((first == 'B') ? 'W' : 'B');
+}
+
+//write, writes the header, starting position and hops of the game
+//parameters: a pointer to an open file, a char for the result, 'B' or 'W' for the winner, 'D' for a
+//draw, or 0 for an unfinished game
+//returns: a bool for whether the game was written
+bool Record::write(FILE *file, char result) {
+    Record_header header;
+    memset(&header, 0, sizeof(header));
+    header.magic = MAGIC, header.version = VERSION;
+    header.result = result;
+    header.hops = hops.size();
+
+    bool reversed = (start.look(0, 0) != ' ');
+    if (reversed)
+        header.flags |= REVERSED;
+    if (first == 'W')
+        header.flags |= WHITE_FIRST;
+
+    //two squares to a byte
+    for (int s = 0; s < 32; s++) {
+        int row = s / 4;
+        int col = (2 * (s % 4)) + ((((row % 2) == 0) != reversed) ? 1 : 0);
+        const char *piece = strchr(PIECES, start.look(row, col));
+        int code = (piece == NULL) ? 0 : (piece - PIECES);
+        header.squares[s / 2] |= code << (4 * (s % 2));
+    }
+
+    return (fwrite(&header, sizeof(header), 1, file) == 1) &&
+    ((hops.empty()) || (fwrite(&hops[0], sizeof(uint16_t), hops.size(), file) == hops.size()));
+}
+
+//read, reads a game written by write, replaying it to find where each turn starts
+//parameters: a pointer to an open file, a ref to the char to set to the result
+//returns: a bool for whether a whole game was read
+bool Record::read(FILE *file, char &result) {
+    Record_header header;
+    if ((fread(&header, sizeof(header), 1, file) != 1) || (header.magic != MAGIC) ||
+    (header.version != VERSION))
+        return false;
+
+    vector<uint16_t> list(header.hops);
+    if ((header.hops > 0) && (fread(&list[0], sizeof(uint16_t), header.hops, file) != header.hops))
+        return false;
+
+    char squares[32];
+    for (int s = 0; s < 32; s++) {
+        int code = (header.squares[s / 2] >> (4 * (s % 2))) & 0xF;
+        squares[s] = (code < 5) ? PIECES[code] : PIECES[0];
+    }
+
+    bool reversed = ((header.flags & REVERSED) != 0);
+    start.setup(squares, reversed);
+    last = start;
+    first = ((header.flags & WHITE_FIRST) != 0) ? 'W' : 'B';
+    turn = first;
+    result = header.result;
+    hops = list;
+    turn_start.clear();
+    keys.clear();
+    quiet.clear();
+    add_key(false);
+
+    bool reversible = false;
+    for (size_t i = 0; i < hops.size(); i++) {
+        char col1, col2;
+        int row1, row2;
+        unpack(hops[i], reversed, col1, row1, col2, row2);
+
+        if (!(hops[i] & AGAIN)) {
+            char piece = last.look(row1, col1 - 'A');
+            reversible = (abs(row2 - row1) == 1) && ((piece == 'B') || (piece == 'R'));
+            turn_start.push_back(i);
+        }
+
+        last.make_move(col1, row1, col2, row2);
+
+        //the turn ends unless the next hop continues it
+        if ((i + 1 == hops.size()) || (!(hops[i + 1] & AGAIN))) {
+            turn = (turn == 'B') ? 'W' : 'B';
+            add_key(reversible);
+        }
+    }
+
+    return true;
+}
+
+//constructor, opens a record file for appending
+//parameters: a ref to the file name
+//returns: NA
+Record_writer::Record_writer(const string &name) {
+    file = fopen(name.c_str(), "ab");
+    if (file == NULL)
+        cout << "Could not open " << name << ", games won't be recorded\n";
+}
+
+//destructor, closes the record file
+//parameters: NA
+//returns: NA
+Record_writer::~Record_writer() {
+    if (file != NULL)
+        fclose(file);
+}
+
+//write, appends a game to the file and flushes it, so a run that's stopped early keeps its games
+//parameters: a ref to the game record, a char for the result
+//returns: a bool for whether the game was written
+bool Record_writer::write(Record &game, char result) {
+    if (file == NULL)
+        return false;
+
+    return (game.write(file, result)) && (fflush(file) == 0);
+}
+
+//constructor, opens a record file for reading
+//parameters: a ref to the file name
+//returns: NA
+Record_reader::Record_reader(const string &name) {
+    file = fopen(name.c_str(), "rb");
+}
+
+//destructor, closes the record file
+//parameters: NA
+//returns: NA
+Record_reader::~Record_reader() {
+    if (file != NULL)
+        fclose(file);
+}
+
+//next, reads the next game from the file
+//parameters: a ref to the record to read into, a ref to the char to set to the result
+//returns: a bool for whether there was another game
+bool Record_reader::next(Record &game, char &result) {
+    if (file == NULL)
+        return false;
+
+    return game.read(file, result);
+}
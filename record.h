@@ -0,0 +1,140 @@
+/*record.h, the header file for game records. A game is kept as its starting position and a list of
+hops, two bytes each, rather than a copy of the Board after every turn, and any earlier position is
+rebuilt by replaying the hops from the start.
+
+Record_writer appends finished games to a binary file as they end, and Record_reader reads them back
+one at a time, so a whole tournament can be logged and replayed without any text processing.*/
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include "board.h"
+
+using namespace std;
+
+#ifndef RECORD_H
+#define RECORD_H
+
+//fixed-size header at the start of every game in a record file, followed by its hops
+struct Record_header {
+    uint16_t magic;
+    uint8_t version, flags;
+    uint8_t result, reserved[3];
+    uint32_t hops;
+    uint8_t squares[16];
+};
+
+class Record {
+    private:
+        //position the game started from, and the position after the last recorded turn
+        Board start, last;
+
+        //color to move at the start, and next to move
+        char first, turn;
+
+        //hops, as from and to squares with a bit for a hop that continues the same turn
+        vector<uint16_t> hops;
+
+        //index of the first hop of each turn
+        vector<uint32_t> turn_start;
+
+        //hash of each position, starting with the starting position, and the number of reversible
+        //turns, king moves without a take, that led up to it
+        vector<uint64_t> keys;
+        vector<uint16_t> quiet;
+
+        //record the hash of the last position, after a turn that was reversible or not
+        void add_key(bool reversible);
+
+        //pack a hop into two bytes
+        static uint16_t pack(int col1, int row1, int col2, int row2, bool again);
+
+        //unpack a hop for a board in a given orientation
+        static void unpack(uint16_t hop, bool reversed, char &col1, int &row1, char &col2, int &row2);
+
+        //recursive helper to add_turn, searches for the hops that lead from one position to another
+        bool find_hops(Board &ref, Board &after, char color, int col, int row, bool again);
+
+    public:
+        /***Constants***/
+
+        //file identification
+        const static uint16_t MAGIC = 0x5247;
+        const static uint8_t VERSION = 1;
+
+        //bits in a packed hop, and in the header flags
+        const static uint16_t AGAIN = 0x400;
+        const static uint8_t REVERSED = 1, WHITE_FIRST = 2;
+
+        //constructor, for a game from the standard starting position with black to move
+        Record();
+
+        //constructor, for a game from a given position and color to move
+        Record(const Board &ref, char color);
+
+        //record the turn that led from the last position to a new one, returns false if no legal
+        //turn does
+        bool add_turn(Board &after);
+
+        //get the number of turns recorded
+        int get_turns() {
+            return turn_start.size();
+        }
+
+        //get the number of hops recorded
+        int get_hops() {
+            return hops.size();
+        }
+
+        //get the hashes of the positions since the last take or man move, the only ones that can
+        //come up again, ending with the current position
+        vector<uint64_t> get_history();
+
+        //count the times the current position has come up, including now
+        int repetitions();
+
+        //rebuild the position after a number of turns
+        Board position(int turns);
+
+        //drop every turn after a number of turns, to undo them
+        void truncate(int turns);
+
+        //write the game and its result to an open file, returns false on failure
+        bool write(FILE *file, char result);
+
+        //read a game and its result from an open file, returns false at the end of the file
+        bool read(FILE *file, char &result);
+};
+
+class Record_writer {
+    private:
+        FILE *file;
+
+    public:
+        //constructor, opens a file to append games to
+        Record_writer(const string &name);
+
+        //destructor, closes the file
+        ~Record_writer();
+
+        //append a finished game and flush it, returns false on failure
+        bool write(Record &game, char result);
+};
+
+class Record_reader {
+    private:
+        FILE *file;
+
+    public:
+        //constructor, opens a file of games
+        Record_reader(const string &name);
+
+        //destructor, closes the file
+        ~Record_reader();
+
+        //read the next game, returns false once there are none left
+        bool next(Record &game, char &result);
+};
+
+#endif
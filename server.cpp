@@ -0,0 +1,384 @@
+/*server.cpp, the main for the analysis server. Runs Thomas as a long-lived process speaking a line
+protocol on standard input and output, so positions can be analysed one after another without
+setting up a new engine each time, and with his transposition table kept between them.
+
+Commands:
+    position startpos [moves m1 m2 ...]
+    position fen <FEN> [moves m1 m2 ...]
+    go [depth N] [movetime MS] [nodes N] [multipv K]
+    stop
+    isready
+    newgame
+    hash <MB>
+    quit
+
+Moves are in PDN notation, 11-15 for a move and 15x24 or 15x24x31 for a jump, with every square of a
+multiple jump given. While searching, the server prints a line for each completed depth, with the
+score for the side to move,
+    info depth D score S nodes N nps N time MS pv m1 m2 ...
+With multipv, each depth prints a line for each of the K best moves, best first, numbered from 1,
+    info depth D multipv I score S nodes N nps N time MS pv m1 m2 ...
+and when the search ends, by reaching its limits or with stop,
+    bestmove m
+
+Thomas only searches for black, so a position with white to move is turned around for him, and his
+moves turned back.
+
+Usage: ./server*/
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <chrono>
+#include "board.h"
+#include "AI.h"
+#include "record.h"
+
+using namespace std;
+
+//the game being analysed, as played from its starting position, and the same game turned around, for
+//searching with white to move
+struct Game {
+    Board now;
+    char turn;
+    Record played, flipped;
+};
+
+//lock for printing from both the reading and searching threads
+mutex output;
+
+//print a line of the protocol
+void send(const string &line);
+
+//set up a game from a position command, returns false if it isn't valid
+bool set_position(istringstream &words, Game &game);
+
+//play a move in PDN notation on the game, returns false if it isn't legal
+bool play_move(Game &game, const string &text);
+
+//start a search from a go command
+void go(istringstream &words, Game &game, AI *Thomas, thread &search);
+
+//search and print the best move, run on its own thread
+void think(AI *Thomas, Board position, char turn);
+
+//end a search, if one is running
+void finish(AI *Thomas, thread &search);
+
+//get the standard number of a square, for a board that's been turned around or not
+int square_number(int row, int col, bool flipped);
+
+//write the turns of a line of play in PDN notation, from the position it starts at
+string line_text(const Search_line &pv, Board position, bool flipped, int turns);
+
+int main() {
+    AI *Thomas = new AI;
+    Thomas->use_book(false); //analysis is of the search
+    thread search;
+
+    Game game;
+    istringstream start("startpos");
+    set_position(start, game);
+
+    string line;
+    while (getline(cin, line)) {
+        istringstream words(line);
+        string command;
+        words >> command;
+
+        if (command == "position") {
+            finish(Thomas, search);
+            if (!set_position(words, game))
+                send("error invalid position");
+        } else if (command == "go") {
+            finish(Thomas, search);
+            go(words, game, Thomas, search);
+        } else if (command == "stop") {
+            finish(Thomas, search);
+        } else if (command == "isready") {
+            send("readyok");
+        } else if (command == "newgame") {
+            finish(Thomas, search);
+            Thomas->clear_hash(); //start over with an empty table
+        } else if (command == "hash") {
+            int mb = 0;
+            finish(Thomas, search);
+            if (words >> mb) {
+                Thomas->set_hash(mb);
+            } else {
+                send("error invalid hash size");
+            }
+        } else if (command == "quit") {
+            break;
+        } else if (command != "") {
+            send("error unknown command " + command);
+        }
+    }
+
+    finish(Thomas, search);
+    delete Thomas;
+
+    return 0;
+}
+
+//send, prints a line and flushes it, so the other end sees it straight away
+//parameters: a ref to the line
+//returns: void
+void send(const string &line) {
+    lock_guard<mutex> hold(output);
+    cout << line << endl;
+}
+
+//set_position, sets up the game from the rest of a position command, a starting position and moves
+//parameters: a ref to the stream of words after the command, a ref to the game
+//returns: a bool for whether the position and moves were valid, the game is unchanged if not
+bool set_position(istringstream &words, Game &game) {
+    Game next;
+    string word;
+    words >> word;
+
+    if (word == "startpos") {
+        next.turn = 'B';
+        words >> word;
+    } else if (word == "fen") {
+        //the FEN runs up to the moves, if there are any
+        string fen;
+        while ((words >> word) && (word != "moves"))
+            fen += word;
+
+        if (!next.now.from_fen(fen.c_str(), next.turn))
+            return false;
+    } else {
+        return false;
+    }
+
+    Board turned(next.now);
+    turned.flip();
+    next.played = Record(next.now, next.turn);
+    next.flipped = Record(turned, (next.turn == 'B') ? 'W' : 'B');
+
+    if (word == "moves") {
+        while (words >> word) {
+            if (!play_move(next, word))
+                return false;
+        }
+    }
+
+    game = next;
+    return true;
+}
+
+//play_move, plays a move given in PDN notation, every square of a multiple jump included
+//parameters: a ref to the game, a ref to the move's text
+//returns: a bool for whether the move was legal and complete
+bool play_move(Game &game, const string &text) {
+    vector<int> squares;
+    int number = 0;
+    bool jump = false;
+
+    for (size_t i = 0; i <= text.size(); i++) {
+        if ((i < text.size()) && (isdigit(text[i]))) {
+            number = (number * 10) + (text[i] - '0');
+        } else if ((i == text.size()) || (text[i] == '-') || (text[i] == 'x') || (text[i] == 'X')) {
+            if ((number < 1) || (number > 32))
+                return false;
+            squares.push_back(number - 1);
+            number = 0;
+            if ((i < text.size()) && (text[i] != '-'))
+                jump = true;
+        } else {
+            return false;
+        }
+    }
+
+    if ((squares.size() < 2) || ((!jump) && (squares.size() > 2)))
+        return false;
+
+    Board after(game.now);
+    for (size_t i = 0; i + 1 < squares.size(); i++) {
+        int row1 = squares[i] / 4, row2 = squares[i + 1] / 4;
+        int col1 = (2 * (squares[i] % 4)) + (((row1 % 2) == 0) ? 1 : 0);
+        int col2 = (2 * (squares[i + 1] % 4)) + (((row2 % 2) == 0) ? 1 : 0);
+
+        if ((!after.check_validity('A' + col1, row1, 'A' + col2, row2, game.turn)) ||
+        ((i > 0) && (abs(row2 - row1) != 2)))
+            return false;
+
+        after.make_move('A' + col1, row1, 'A' + col2, row2);
+
+        //a jump has to go on as long as it can
+        bool again = (abs(row2 - row1) == 2) && (after.jump_possible('A' + col2, row2, game.turn)) &&
+        (!after.kinged());
+        if (again != (i + 2 < squares.size()))
+            return false;
+    }
+
+    Board turned(after);
+    turned.flip();
+    game.played.add_turn(after);
+    game.flipped.add_turn(turned);
+    game.now = after;
+    game.turn = (game.turn == 'B') ? 'W' : 'B';
+
+    return true;
+}
+
+//go, starts Thomas searching the game's position on his own thread, within the limits given
+//parameters: a ref to the stream of words after the command, a ref to the game, a pointer to
+//Thomas, a ref to the searching thread
+//returns: void
+void go(istringstream &words, Game &game, AI *Thomas, thread &search) {
+    int depth = 0, lines = 1;
+    long long movetime = 0, nodes = 0;
+    string word;
+
+    while (words >> word) {
+        if (word == "depth") {
+            words >> depth;
+        } else if (word == "movetime") {
+            words >> movetime;
+        } else if (word == "nodes") {
+            words >> nodes;
+        } else if (word == "multipv") {
+            words >> lines;
+        }
+    }
+
+    Board position(game.now);
+    if (game.turn == 'W') {
+        position.flip();
+        Thomas->set_history(game.flipped.get_history());
+    } else {
+        Thomas->set_history(game.played.get_history());
+    }
+
+    //the game is already over
+    if (position.check_win('W')) {
+        send("bestmove none");
+        return;
+    }
+
+    Thomas->update_AI(position);
+    Thomas->set_limits(depth, movetime, nodes);
+    Thomas->set_multi_pv(lines);
+    search = thread(think, Thomas, position, game.turn);
+}
+
+//think, runs a search to its limits, printing each completed depth and then the best move
+//parameters: a pointer to Thomas, the position he's searching, as black, and a char for the color
+//really moving
+//returns: void
+void think(AI *Thomas, Board position, char turn) {
+    bool flipped = (turn == 'W');
+    Search_line best;
+    best.length = 0;
+    long long start = chrono::duration_cast<chrono::milliseconds>(
+    chrono::steady_clock::now().time_since_epoch()).count();
+
+    Thomas->set_reporter([&](const Search_info &info) {
+        long long now = chrono::duration_cast<chrono::milliseconds>(
+        chrono::steady_clock::now().time_since_epoch()).count();
+        long long time = (now > start) ? (now - start) : 1;
+
+        for (int i = 0; i < info.lines; i++) {
+            ostringstream text;
+            text << "info depth " << info.depth;
+            if (info.lines > 1)
+                text << " multipv " << i + 1;
+            text << " score " << info.scores[i] << " nodes " << info.nodes << " nps "
+            << (info.nodes * 1000) / time << " time " << time << " pv "
+            << line_text(info.pv_lines[i], position, flipped, PV_MAX);
+            send(text.str());
+        }
+        best = info.pv;
+    });
+
+    Thomas->move(true);
+
+    //stopped before finishing any depth, so make a quick move instead
+    if (Thomas->get_depth() == 0) {
+        Thomas->update_AI(position);
+        Thomas->set_limits(1, 0, 0); //clears the stop, and a depth of 1 ends on its own
+        Thomas->move(true);
+    }
+
+    Thomas->set_reporter(NULL);
+
+    if (best.length == 0) {
+        send("bestmove none");
+    } else {
+        send("bestmove " + line_text(best, position, flipped, 1));
+    }
+}
+
+//finish, stops a running search and waits for it to print its move
+//parameters: a pointer to Thomas, a ref to the searching thread
+//returns: void
+void finish(AI *Thomas, thread &search) {
+    if (search.joinable()) {
+        Thomas->stop();
+        search.join();
+    }
+}
+
+//square_number, gets the standard number of a square, 1 to 32 from black's side
+//parameters: ints for the row and column, a bool for whether the board has been turned around
+//returns: an int for the square number
+int square_number(int row, int col, bool flipped) {
+    int s = ((row * 8) + col) / 2;
+    return (flipped ? (31 - s) : s) + 1;
+}
+
+//line_text, writes the turns of a line of play in PDN notation, finishing a multiple jump the line
+//stops partway through with the first jump that goes on
+//parameters: a ref to the line, the position it starts at, a bool for whether the position has been
+//turned around, an int for the most turns to write
+//returns: a string of the moves, separated by spaces
+string line_text(const Search_line &pv, Board position, bool flipped, int turns) {
+    string text;
+    char color = 'B';
+    int written = 0;
+
+    for (int i = 0; (i < pv.length) && (written < turns); i++) {
+        char c1 = pv.col1[i], c2 = pv.col2[i];
+        int r1 = pv.row1[i], r2 = pv.row2[i];
+        bool jump = (abs(r2 - r1) == 2);
+
+        if (!pv.again[i]) {
+            if (text != "")
+                text += " ";
+            text += to_string(square_number(r1, c1 - 'A', flipped));
+        }
+        text += jump ? "x" : "-";
+        text += to_string(square_number(r2, c2 - 'A', flipped));
+        position.make_move(c1, r1, c2, r2);
+
+        bool again = jump && (position.jump_possible(c2, r2, color)) && (!position.kinged());
+        if ((again) && ((i + 1 == pv.length) || (!pv.again[i + 1]))) {
+            //the line ends partway through a multiple jump, so finish it
+            while ((position.jump_possible(c2, r2, color)) && (!position.kinged())) {
+                char from_c = c2;
+                int from_r = r2;
+                for (int dir = 0; dir < 4; dir++) {
+                    r2 = from_r + (((dir / 2) == 0) ? -2 : 2);
+                    c2 = from_c + (((dir % 2) == 0) ? -2 : 2);
+                    if (position.check_validity(from_c, from_r, c2, r2, color))
+                        break;
+                }
+                position.make_move(from_c, from_r, c2, r2);
+                text += "x" + to_string(square_number(r2, c2 - 'A', flipped));
+            }
+            break;
+        }
+
+        if (!again) {
+            color = (color == 'B') ? 'W' : 'B';
+            written++;
+        }
+    }
+
+    return text;
+}
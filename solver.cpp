@@ -0,0 +1,243 @@
+/*.cpp file for the Solver class, the proof-number search that proves endgames won or lost. A position
+is proved for one side at a time, the attacker, so a draw is simply a position the attacker can't
+prove, and a position is settled for both sides by trying each in turn.
+
+At a position with the attacker to move, proving any one move is enough, so its proof number is the
+least of its moves' and its disproof number the sum. With the defender to move, every move has to be
+proved, and it's the other way around. The search goes down to the move that sets the position's
+number, and comes back up once that number passes the next best move's, or the position's share of
+its parent's thresholds.*/
+
+#include <vector>
+#include <algorithm>
+#include <stdint.h>
+#include "board.h"
+#include "tablebase.h"
+#include "table.h"
+#include "solver.h"
+
+using namespace std;
+
+const uint8_t Solver::UNKNOWN, Solver::WIN, Solver::LOSS;
+const uint32_t Solver::INF;
+
+//constructor, makes an empty table and opens the endgame databases
+//parameters: an int for the table size in megabytes
+//returns: NA
+Solver::Solver(int mb) {
+    memory = new Table<Entry>(mb);
+    endgame = new Tablebase("db", TB_CACHE); //fills the indexing tables too
+
+    nodes = 0, limit = 0, round = 0;
+    attacker = true;
+}
+
+//destructor
+//parameters: NA
+//returns: NA
+Solver::~Solver() {
+    delete memory;
+    delete endgame;
+}
+
+//solve, tries to prove a position won for the side to move, and if that fails, lost
+//parameters: a ref to the Board, a char for the color to move, a long long for the positions each
+//try may search
+//returns: WIN or LOSS for the side to move if either was proved, otherwise UNKNOWN
+uint8_t Solver::solve(Board &ref, char turn, long long budget) {
+    TB_position pos = Tablebase::convert(ref);
+    bool black = (turn == 'B');
+
+    memory->next_age();
+    round++; //only proofs are kept from earlier solves
+    nodes = 0;
+
+    limit = budget;
+    if (prove(pos, black, black))
+        return WIN;
+
+    limit = nodes + budget;
+    if (prove(pos, black, !black))
+        return LOSS;
+
+    return UNKNOWN;
+}
+
+//prove, searches a position until it's proved or disproved for one side, or the budget runs out
+//parameters: a ref to the position, a bool for whether black is to move, a bool for whether black is
+//the side being proved to win
+//returns: a bool for whether the win was proved
+bool Solver::prove(const TB_position &pos, bool black, bool side) {
+    uint32_t proof, disproof;
+    attacker = side;
+    path.clear();
+
+    search(pos, black, hash(pos, black), proof, disproof, INF, INF);
+
+    return (proof == 0);
+}
+
+//search, the df-pn search of a position, going down to its most proving move again and again until
+//the position's proof or disproof number reaches its threshold. A move back to a position on the line
+//being searched counts as disproved, since going around in a circle proves nothing.
+//parameters: a ref to the position, a bool for whether black is to move, its hash, refs to its proof
+//and disproof numbers, set when it returns, and the thresholds for them
+//returns: void
+void Solver::search(const TB_position &pos, bool black, uint64_t key, uint32_t &proof, uint32_t &disproof,
+uint32_t max_proof, uint32_t max_disproof) {
+    long long start = nodes;
+    vector<TB_position> moves;
+    nodes++;
+
+    if (settle(pos, black, moves, proof, disproof)) {
+        save(key, proof, disproof, 1);
+        return;
+    }
+
+    if (path.size() >= MAX_PLY) {
+        proof = INF, disproof = 0; //too long to tell, and not stored since it depends on the line
+        return;
+    }
+
+    bool attacking = (black == attacker);
+    int count = moves.size();
+    vector<uint64_t> keys(count);
+    vector<bool> repeats(count);
+    for (int i = 0; i < count; i++) {
+        keys[i] = hash(moves[i], !black);
+        repeats[i] = (find(path.begin(), path.end(), keys[i]) != path.end());
+    }
+
+    path.push_back(key);
+
+    while (true) {
+        //the side to move takes the move best for it, the least of the numbers for its own result,
+        //and the other number is the sum, since every move would have to go the other way
+        uint32_t least = INF, second = INF, sum = 0;
+        uint32_t best_proof = INF, best_disproof = 0;
+        int best = 0;
+        for (int i = 0; i < count; i++) {
+            uint32_t p = INF, d = 0;
+            if (!repeats[i])
+                look_up(keys[i], p, d);
+
+            uint32_t mine = attacking ? p : d;
+            sum = add(sum, attacking ? d : p);
+            if (mine < least) {
+                second = least, least = mine;
+                best = i, best_proof = p, best_disproof = d;
+            } else if (mine < second) {
+                second = mine;
+            }
+        }
+
+        proof = attacking ? least : sum;
+        disproof = attacking ? sum : least;
+        if ((proof >= max_proof) || (disproof >= max_disproof) || (nodes >= limit))
+            break;
+
+        //the best move is searched until it's no longer the best, or the position would pass its own
+        //threshold
+        uint32_t child_proof, child_disproof;
+        if (attacking) {
+            child_proof = min(max_proof, add(second, 1));
+            child_disproof = add(max_disproof - disproof, best_disproof);
+        } else {
+            child_proof = add(max_proof - proof, best_proof);
+            child_disproof = min(max_disproof, add(second, 1));
+        }
+
+        search(moves[best], !black, keys[best], best_proof, best_disproof, child_proof, child_disproof);
+    }
+
+    path.pop_back();
+    save(key, proof, disproof, nodes - start);
+}
+
+//settle, decides a position without searching it: a side with no moves has lost, and a position
+//with few enough pieces is looked up in the databases, where a draw is a win for neither side
+//parameters: a ref to the position, a bool for whether black is to move, a ref to a vector filled with
+//the positions after each move, and refs to the proof and disproof numbers, set if it's decided
+//returns: a bool for whether the position was decided
+bool Solver::settle(const TB_position &pos, bool black, vector<TB_position> &moves, uint32_t &proof,
+uint32_t &disproof) {
+    bool won = false; //for the side to move
+    Tablebase::successors(pos, black, moves);
+
+    if (!moves.empty()) {
+        uint32_t all = pos.black_men | pos.black_kings | pos.white_men | pos.white_kings;
+        if (__builtin_popcount(all) > endgame->get_pieces())
+            return false;
+
+        int dist;
+        uint8_t value = endgame->probe(pos, black, dist);
+        if (value == Tablebase::UNKNOWN) {
+            return false;
+        } else if (value == Tablebase::DRAW) {
+            proof = INF, disproof = 0;
+            return true;
+        }
+
+        won = (value == Tablebase::WIN);
+    }
+
+    bool proved = (won == (black == attacker));
+    proof = proved ? 0 : INF;
+    disproof = proved ? INF : 0;
+    return true;
+}
+
+//look_up, gets a position's proof and disproof numbers from the table, starting at 1 each for one
+//that isn't there. Only proofs are used from an earlier solve, since a disproof may have come from a
+//repetition of a line that's no longer being played.
+//parameters: the position's hash, refs to the numbers
+//returns: void
+void Solver::look_up(uint64_t key, uint32_t &proof, uint32_t &disproof) {
+    Entry *place = memory->find(key);
+    if ((place == NULL) || ((place->round != round) && (place->proof != 0))) {
+        proof = 1, disproof = 1;
+        return;
+    }
+
+    proof = place->proof, disproof = place->disproof;
+}
+
+//save, stores a position's numbers, over its old ones if it's there already
+//parameters: the position's hash, its proof and disproof numbers, and the positions searched to get them
+//returns: void
+void Solver::save(uint64_t key, uint32_t proof, uint32_t disproof, long long work) {
+    uint8_t depth = 0;
+    while ((work >>= 1) > 0)
+        depth++;
+
+    Entry *place = memory->find(key);
+    if (place != NULL) {
+        place->proof = proof, place->disproof = disproof, place->round = round;
+        if (depth > place->depth)
+            place->depth = depth;
+        return;
+    }
+
+    Entry temp;
+    temp.proof = proof, temp.disproof = disproof, temp.round = round;
+    temp.depth = depth;
+    memory->store(key, temp);
+}
+
+//hash, mixes a position, the side to move and the side being proved to win into a table key
+//parameters: a ref to the position, a bool for whether black is to move
+//returns: the hash, never 0, which marks an empty slot
+uint64_t Solver::hash(const TB_position &pos, bool black) {
+    uint64_t words[3] = {((uint64_t) pos.black_men << 32) | pos.white_men,
+    ((uint64_t) pos.black_kings << 32) | pos.white_kings, (uint64_t) ((black ? 1 : 0) | (attacker ? 2 : 0))};
+    uint64_t key = 0;
+
+    for (int i = 0; i < 3; i++) {
+        key = (key ^ words[i]) + 0x9E3779B97F4A7C15ULL;
+        key = (key ^ (key >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        key = (key ^ (key >> 27)) * 0x94D049BB133111EBULL;
+        key ^= key >> 31;
+    }
+
+    return (key != 0) ? key : 1;
+}
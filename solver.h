@@ -0,0 +1,110 @@
+/*solver.h, the header file for the Solver class, a depth-first proof-number (df-pn) search that tries
+to prove a position won or lost outright, rather than score it. Each position has a proof number, the
+least number of positions that would have to be shown won to prove it, and a disproof number, the same
+for showing it isn't, and the search always goes down to the position that's cheapest to settle,
+within thresholds that bring it back up once a sibling has become cheaper.
+
+Positions are generated in the databases' format, with whole turns, multiple jumps included, as
+single moves. The endgame databases settle positions with few enough pieces. Draws, repetitions of
+the line being searched and positions the budget runs out on are never proofs, so a win is only ever
+reported when it's forced.
+
+Proof and disproof numbers are kept in a transposition table of fixed size, so a solve runs in bounded
+memory however many positions it visits, and kept from solve to solve, so later positions of the same
+game are settled faster.*/
+
+#include <vector>
+#include <stdint.h>
+#include "board.h"
+#include "tablebase.h"
+#include "table.h"
+
+using namespace std;
+
+#ifndef SOLVER_H
+#define SOLVER_H
+
+class Solver {
+    public:
+        //results, for the side to move
+        const static uint8_t UNKNOWN = 0, WIN = 1, LOSS = 2;
+
+        //constructor, with a transposition table of a given size in megabytes
+        Solver(int mb);
+
+        //destructor
+        ~Solver();
+
+        //try to prove a position won or lost for the side to move, searching up to a budget of
+        //positions for each
+        uint8_t solve(Board &ref, char turn, long long budget);
+
+        //get the positions searched by the last solve
+        long long get_nodes() {
+            return nodes;
+        }
+
+    private:
+        //stored position, with its proof and disproof numbers for the side being proved to win, the 
+        //positions it took, as a power of 2, for deciding what to keep, and the solve it's from
+        struct Entry {
+            uint64_t key;
+            uint32_t proof, disproof;
+            uint8_t depth;
+            uint8_t age;
+            uint16_t round;
+        };
+
+        //transposition table, kept from solve to solve
+        Table<Entry> *memory;
+
+        //endgame databases
+        Tablebase *endgame;
+
+        //side being proved to win, whether black, positions searched so far, and the most that may be
+        long long nodes, limit;
+        bool attacker;
+
+        //count of solves, for telling entries from earlier ones
+        uint16_t round;
+
+        //hashes of the positions on the line being searched, for finding repetitions
+        vector<uint64_t> path;
+
+        //number that can't be reached, for a position proved or disproved
+        const static uint32_t INF = 100000000;
+
+        //deepest line searched, past which a position counts as not proved
+        const static int MAX_PLY = 400;
+
+        //decoded blocks of the endgame databases kept
+        const static int TB_CACHE = 256;
+
+        //try to prove one side wins, returns whether it was proved
+        bool prove(const TB_position &pos, bool black, bool side);
+
+        //search below a position until its numbers reach the thresholds
+        void search(const TB_position &pos, bool black, uint64_t key, uint32_t &proof, uint32_t &disproof,
+        uint32_t max_proof, uint32_t max_disproof);
+
+        //get the stored numbers of a position, or the starting ones if it isn't stored
+        void look_up(uint64_t key, uint32_t &proof, uint32_t &disproof);
+
+        //store a position's numbers
+        void save(uint64_t key, uint32_t proof, uint32_t disproof, long long work);
+
+        //settle a position without searching it, by its moves or the databases, returns false if it
+        //can't be
+        bool settle(const TB_position &pos, bool black, vector<TB_position> &moves, uint32_t &proof,
+        uint32_t &disproof);
+
+        //hash a position with the side to move and the side being proved to win
+        uint64_t hash(const TB_position &pos, bool black);
+
+        //add proof or disproof numbers without going past INF
+        static uint32_t add(uint32_t a, uint32_t b) {
+            return ((a >= INF) || (b >= INF) || (a + b >= INF)) ? INF : a + b;
+        }
+};
+
+#endif
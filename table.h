@@ -0,0 +1,219 @@
+/*table.h, the header file for the Table class template, the transposition table both AIs keep their
+searched positions in, and for Mem_node, the entry they store in it. Whatever kind of entry a table
+holds has to have the position's hash as key, the depth it was searched to as depth, and an age, and be
+all zeros when empty.
+
+Entries go one to a slot picked by the hash, and are kept from move to move. A position already in its
+slot is replaced only by a deeper search of it, and another position only once it was left by an
+earlier move or searched no deeper.
+
+Being a template, the whole class is in this header.*/
+
+#include <cstring>
+#include <thread>
+#include <vector>
+#include <stdint.h>
+#include <sys/mman.h>
+
+using namespace std;
+
+#ifndef TABLE_H
+#define TABLE_H
+
+template <class Entry>
+class Table {
+    private:
+        //the slots, how many there are, a power of 2, the bytes they take, and whether they were
+        //mapped or allocated
+        Entry *memory;
+        uint64_t size;
+        size_t bytes;
+        bool mapped;
+
+        //count of moves searched, for telling entries left by earlier moves from this one's
+        uint8_t age;
+
+        //make an empty table of a given size in megabytes
+        void allocate(int mb);
+
+        //give the table's memory back
+        void release();
+
+        //empty a range of slots, run on a thread by clear
+        void clear_range(uint64_t first, uint64_t last);
+
+    public:
+        //constructor, makes an empty table of a given size in megabytes
+        Table(int mb);
+
+        //destructor
+        ~Table();
+
+        //replace the table with an empty one of a given size in megabytes
+        void resize(int mb);
+
+        //empty the table
+        void clear();
+
+        //start a new move, after which entries from earlier ones can be overwritten
+        void next_age() {
+            age++;
+        }
+
+        //find a position, returns NULL if it isn't stored
+        Entry* find(uint64_t key);
+
+        //store a searched position, if it's worth more than what's in its slot
+        void store(uint64_t key, Entry &temp);
+
+        //start loading a position's slot into the cache, the key at the front and the rest of a
+        //larger entry, ahead of the probe
+        void prefetch(uint64_t key) {
+            Entry *slot = &memory[key & (size - 1)];
+            __builtin_prefetch(slot);
+            if (sizeof(Entry) > 64)
+                __builtin_prefetch((char*) slot + sizeof(Entry) - 1);
+        }
+};
+
+//stored position of a minimax search, with the position's hash, its score, the best move found from it,
+//whether the score is exact or a bound from a cutoff, and the move it was last used on. The other moves
+//are generated again when it comes up, so an entry takes a few bytes rather than a move list.
+struct Mem_node {
+    uint64_t key;
+    int score;
+    char col1, col2, row1, row2;
+    char depth;
+    char bound;
+    uint8_t age;
+};
+
+//constructor, makes an empty table
+//parameters: an int for the size in megabytes
+//returns: NA
+template <class Entry>
+Table<Entry>::Table(int mb) {
+    allocate((mb > 0) ? mb : 1);
+}
+
+//destructor
+//parameters: NA
+//returns: NA
+template <class Entry>
+Table<Entry>::~Table() {
+    release();
+}
+
+//resize, replaces the table with an empty one of a given size
+//parameters: an int for the size in megabytes, rounded down to a power of 2 slots
+//returns: void
+template <class Entry>
+void Table<Entry>::resize(int mb) {
+    release();
+    allocate((mb > 0) ? mb : 1);
+}
+
+//allocate, makes an empty table, as the largest power of 2 slots that fits. It's mapped as anonymous
+//memory, which the system hands over already zeroed, and asked for in huge pages where the system has
+//them, since with 4 KB pages almost every probe of a large table misses in the TLB. If mapping fails
+//it's allocated normally and cleared.
+//parameters: an int for the size in megabytes
+//returns: void
+template <class Entry>
+void Table<Entry>::allocate(int mb) {
+    size = 1;
+    while ((size * 2) * sizeof(Entry) <= ((uint64_t) mb << 20))
+        size *= 2;
+
+    bytes = size * sizeof(Entry);
+    age = 0;
+
+    void *block = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (block != MAP_FAILED) {
+#ifdef MADV_HUGEPAGE
+        madvise(block, bytes, MADV_HUGEPAGE); //only advice, normal pages are fine too
+#endif
+        memory = (Entry*) block;
+        mapped = true;
+    } else {
+        memory = new Entry[size];
+        mapped = false;
+        clear();
+    }
+}
+
+//release, gives the table's memory back, however it was allocated
+//parameters: NA
+//returns: void
+template <class Entry>
+void Table<Entry>::release() {
+    if (mapped) {
+        munmap(memory, bytes);
+    } else {
+        delete [] memory;
+    }
+}
+
+//clear, empties the table, splitting the work between a thread for each core, since writing out a
+//table of a few gigabytes takes a while on one
+//parameters: NA
+//returns: void
+template <class Entry>
+void Table<Entry>::clear() {
+    uint64_t workers = thread::hardware_concurrency();
+    if (workers == 0)
+        workers = 1;
+
+    vector<thread> helpers;
+    uint64_t share = size / workers;
+    for (uint64_t i = 0; i < workers; i++) {
+        uint64_t last = (i + 1 == workers) ? size : (i + 1) * share;
+        helpers.push_back(thread(&Table<Entry>::clear_range, this, i * share, last));
+    }
+
+    for (size_t i = 0; i < helpers.size(); i++)
+        helpers[i].join();
+
+    age = 0;
+}
+
+//clear_range, empties a range of slots
+//parameters: the first slot, and the slot after the last
+//returns: void
+template <class Entry>
+void Table<Entry>::clear_range(uint64_t first, uint64_t last) {
+    if (last > first)
+        memset((void*) &memory[first], 0, (last - first) * sizeof(Entry)); //empty slots have a key of 0
+}
+
+//find, looks a position up, marking an entry left by an earlier move as still in use, so it isn't
+//overwritten first
+//parameters: the position's hash, with the color to move
+//returns: a pointer to the entry, NULL if the position isn't stored
+template <class Entry>
+Entry* Table<Entry>::find(uint64_t key) {
+    Entry *slot = &memory[key & (size - 1)];
+    if (slot->key != key)
+        return NULL;
+
+    slot->age = age;
+    return slot;
+}
+
+//store, stores a searched position in its slot. A position already there is kept only if it was searched
+//deeper, so a search to the same depth, which may have an exact score where the entry had a bound,
+//replaces it. Another position is overwritten if it was left by an earlier move or searched no deeper.
+//parameters: the position's hash, with the color to move, a ref to the entry to store
+//returns: void
+template <class Entry>
+void Table<Entry>::store(uint64_t key, Entry &temp) {
+    Entry *slot = &memory[key & (size - 1)];
+    if ((slot->key == key) ? (slot->depth > temp.depth) : ((slot->age == age) &&
+    (slot->depth > temp.depth)))
+        return;
+
+    *slot = temp;
+    slot->key = key, slot->age = age;
+}
+
+#endif
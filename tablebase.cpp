@@ -0,0 +1,638 @@
+/*.cpp file for the Tablebase class, which holds the indexing, move generation and file format shared
+by the endgame database generator and the engines.
+
+Each database covers one material signature, and its positions are numbered by a perfect hash. Black
+men can stand on squares 0 to 27 and white men on squares 4 to 31, so the men are ranked first,
+grouped by how many black men stand on black's back row (the only squares white men can never
+use), so that the white men's domain has a fixed size within each group. Kings are then ranked
+among the squares left empty by the men. Every index is a legal placement, and every placement
+has exactly one index.
+
+Database files store both sides to move, black first, in blocks of BLOCK positions. Each block is
+run-length encoded on its own so a single position can be read by decoding only its block.*/
+
+#include <iostream>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "board.h"
+#include "tablebase.h"
+
+using namespace std;
+
+const uint8_t Tablebase::UNKNOWN, Tablebase::WIN, Tablebase::LOSS, Tablebase::DRAW;
+const uint32_t Tablebase::BLOCK;
+
+uint64_t Tablebase::choose[33][Tablebase::MAX_PIECES + 1];
+int Tablebase::step[32][4];
+
+//squares black men can stand on, and the back row no white man can reach
+const static uint32_t BLACK_MEN_SQUARES = 0x0FFFFFFF, BLACK_BACK_ROW = 0x0000000F;
+
+//squares white men can stand on
+const static uint32_t WHITE_MEN_SQUARES = 0xFFFFFFF0;
+
+//squares where a man of each color is crowned
+const static uint32_t BLACK_CROWN = 0xF0000000, WHITE_CROWN = 0x0000000F;
+
+//init, fills the binomial coefficient table and the neighbouring square table
+//parameters: NA
+//returns: void
+void Tablebase::init() {
+    for (int n = 0; n < 33; n++) {
+        for (int k = 0; k <= MAX_PIECES; k++) {
+            if (k == 0) {
+                choose[n][k] = 1;
+            } else if (n == 0) {
+                choose[n][k] = 0;
+            } else {
+                choose[n][k] = choose[n - 1][k - 1] + choose[n - 1][k];
+            }
+        }
+    }
+
+    for (int s = 0; s < 32; s++) {
+        int row = row_of(s), col = col_of(s);
+        int rows[4] = {row - 1, row - 1, row + 1, row + 1};
+        int cols[4] = {col - 1, col + 1, col - 1, col + 1};
+
+        for (int d = 0; d < 4; d++) {
+            if ((rows[d] < 0) || (rows[d] > 7) || (cols[d] < 0) || (cols[d] > 7)) {
+                step[s][d] = -1;
+            } else {
+                step[s][d] = ((rows[d] * 8) + cols[d]) / 2;
+            }
+        }
+    }
+}
+
+//make_slice, builds the descriptor for a material signature, counting its positions
+//parameters: ints for the numbers of black men, black kings, white men and white kings
+//returns: a TB_slice with the size of the signature for one side to move
+TB_slice Tablebase::make_slice(int bm, int bk, int wm, int wk) {
+    TB_slice slice;
+    slice.bm = bm, slice.bk = bk, slice.wm = wm, slice.wk = wk;
+
+    int free_squares = 32 - bm - wm;
+    int groups = (bm < 4) ? bm : 4;
+    slice.size = men_offset(bm, wm, groups + 1) * choose[free_squares][bk] *
+    choose[free_squares - bk][wk];
+
+    return slice;
+}
+
+//slice_of, finds the material signature of a position
+//parameters: a ref to a position
+//returns: a TB_slice for the position's signature
+TB_slice Tablebase::slice_of(const TB_position &pos) {
+    return make_slice(__builtin_popcount(pos.black_men), __builtin_popcount(pos.black_kings),
+    __builtin_popcount(pos.white_men), __builtin_popcount(pos.white_kings));
+}
+
+//men_offset, counts the men arrangements in the groups before group k, where the group number is
+//the number of black men on black's back row
+//parameters: ints for the numbers of black and white men, an int for the group
+//returns: the number of arrangements before the group
+uint64_t Tablebase::men_offset(int bm, int wm, int k) {
+    uint64_t total = 0;
+
+    for (int j = 0; (j < k) && (j <= bm) && (j <= 4); j++) {
+        total += choose[4][j] * choose[24][bm - j] * choose[28 - bm + j][wm];
+    }
+
+    return total;
+}
+
+//rank, finds the combinatorial rank of a set of squares among the squares of a domain
+//parameters: a mask for the set, a mask for the domain, which must contain the set
+//returns: the rank, from 0 to (domain size choose set size) - 1
+uint64_t Tablebase::rank(uint32_t set, uint32_t domain) {
+    uint64_t r = 0;
+    int i = 1;
+
+    while (set) {
+        int square = __builtin_ctz(set);
+        r += choose[__builtin_popcount(domain & ((1u << square) - 1))][i];
+        set &= set - 1;
+        i++;
+    }
+
+    return r;
+}
+
+//unrank, inverse of rank, rebuilds a set of squares from its rank within a domain
+//parameters: the rank, an int for the number of squares in the set, a mask for the domain
+//returns: a mask for the set
+uint32_t Tablebase::unrank(uint64_t r, int num, uint32_t domain) {
+    uint32_t set = 0;
+    int p = __builtin_popcount(domain) - 1;
+
+    for (int i = num; i > 0; i--) {
+        while (choose[p][i] > r)
+            p--;
+        r -= choose[p][i];
+
+        //find the pth square of the domain
+        uint32_t left = domain;
+        for (int skip = 0; skip < p; skip++)
+            left &= left - 1;
+        set |= 1u << __builtin_ctz(left);
+        p--;
+    }
+
+    return set;
+}
+
+//index, the perfect hash of a position within its slice
+//parameters: a ref to the position's slice and a ref to the position
+//returns: the index, from 0 to slice.size - 1
+uint64_t Tablebase::index(const TB_slice &slice, const TB_position &pos) {
+    int k = __builtin_popcount(pos.black_men & BLACK_BACK_ROW);
+    int rest = slice.bm - k;
+
+    uint64_t men = rank(pos.black_men & BLACK_BACK_ROW, BLACK_BACK_ROW);
+    men = (men * choose[24][rest]) + rank(pos.black_men & ~BLACK_BACK_ROW,
+    BLACK_MEN_SQUARES & ~BLACK_BACK_ROW);
+    men = (men * choose[28 - rest][slice.wm]) + rank(pos.white_men,
+    WHITE_MEN_SQUARES & ~pos.black_men);
+    men += men_offset(slice.bm, slice.wm, k);
+
+    uint32_t empty = ~(pos.black_men | pos.white_men);
+    int free_squares = 32 - slice.bm - slice.wm;
+
+    uint64_t idx = (men * choose[free_squares][slice.bk]) + rank(pos.black_kings, empty);
+    idx = (idx * choose[free_squares - slice.bk][slice.wk]) +
+    rank(pos.white_kings, empty & ~pos.black_kings);
+
+    return idx;
+}
+
+//position, inverse of index, rebuilds the position at an index of a slice
+//parameters: a ref to the slice, the index
+//returns: the position
+TB_position Tablebase::position(const TB_slice &slice, uint64_t idx) {
+    TB_position pos;
+    int free_squares = 32 - slice.bm - slice.wm;
+
+    uint64_t white_kings = idx % choose[free_squares - slice.bk][slice.wk];
+    idx /= choose[free_squares - slice.bk][slice.wk];
+    uint64_t black_kings = idx % choose[free_squares][slice.bk];
+    uint64_t men = idx / choose[free_squares][slice.bk];
+
+    //find the group for the number of black men on black's back row
+    int k = 0;
+    while (men >= men_offset(slice.bm, slice.wm, k + 1))
+        k++;
+    men -= men_offset(slice.bm, slice.wm, k);
+
+    int rest = slice.bm - k;
+    uint64_t white_men = men % choose[28 - rest][slice.wm];
+    men /= choose[28 - rest][slice.wm];
+    uint64_t black_rest = men % choose[24][rest];
+    uint64_t black_back = men / choose[24][rest];
+
+    pos.black_men = unrank(black_back, k, BLACK_BACK_ROW) |
+    unrank(black_rest, rest, BLACK_MEN_SQUARES & ~BLACK_BACK_ROW);
+    pos.white_men = unrank(white_men, slice.wm, WHITE_MEN_SQUARES & ~pos.black_men);
+
+    uint32_t empty = ~(pos.black_men | pos.white_men);
+    pos.black_kings = unrank(black_kings, slice.bk, empty);
+    pos.white_kings = unrank(white_kings, slice.wk, empty & ~pos.black_kings);
+
+    return pos;
+}
+
+//jump_from, continues a jump sequence by a piece, adding the position at the end of every
+//possible sequence to the vector. A man that is crowned ends the sequence.
+//parameters: a ref to the position with the piece on its square, a bool for the color, an int for
+//the square, a bool for whether the piece is a king, a ref to the vector of results
+//returns: a bool for whether any jump was possible from the square
+bool Tablebase::jump_from(const TB_position &pos, bool black, int square, bool king,
+vector<TB_position> &out) {
+    uint32_t enemy = black ? (pos.white_men | pos.white_kings) : (pos.black_men | pos.black_kings);
+    uint32_t occupied = pos.black_men | pos.black_kings | pos.white_men | pos.white_kings;
+    bool found = false;
+
+    for (int d = 0; d < 4; d++) {
+        //men only jump forward, down the board for black and up for white
+        if ((!king) && (black == (d < 2)))
+            continue;
+
+        int over = step[square][d];
+        if ((over < 0) || (!(enemy & (1u << over))))
+            continue;
+        int land = step[over][d];
+        if ((land < 0) || (occupied & (1u << land)))
+            continue;
+
+        found = true;
+        TB_position next = pos;
+        uint32_t from = 1u << square, to = 1u << land, taken = ~(1u << over);
+        next.black_men &= taken, next.black_kings &= taken;
+        next.white_men &= taken, next.white_kings &= taken;
+
+        if (black) {
+            if (king) {
+                next.black_kings = (next.black_kings & ~from) | to;
+            } else if (to & BLACK_CROWN) {
+                next.black_men &= ~from, next.black_kings |= to;
+                out.push_back(next); //crowning ends the turn
+                continue;
+            } else {
+                next.black_men = (next.black_men & ~from) | to;
+            }
+        } else {
+            if (king) {
+                next.white_kings = (next.white_kings & ~from) | to;
+            } else if (to & WHITE_CROWN) {
+                next.white_men &= ~from, next.white_kings |= to;
+                out.push_back(next);
+                continue;
+            } else {
+                next.white_men = (next.white_men & ~from) | to;
+            }
+        }
+
+        if (!jump_from(next, black, land, king, out))
+            out.push_back(next); //sequence ends where no further jump is possible
+    }
+
+    return found;
+}
+
+//successors, generates every position reachable by the side to move in one turn, following the
+//same rules as Board: jumps are forced, multiple jumps must be completed, and crowning ends a turn
+//parameters: a ref to the position, a bool for whether black is to move, a ref to a vector to fill
+//returns: a bool for whether the moves are jumps
+bool Tablebase::successors(const TB_position &pos, bool black, vector<TB_position> &out) {
+    out.clear();
+    uint32_t men = black ? pos.black_men : pos.white_men;
+    uint32_t kings = black ? pos.black_kings : pos.white_kings;
+
+    //forced jumps
+    for (uint32_t pieces = men; pieces; pieces &= pieces - 1)
+        jump_from(pos, black, __builtin_ctz(pieces), false, out);
+    for (uint32_t pieces = kings; pieces; pieces &= pieces - 1)
+        jump_from(pos, black, __builtin_ctz(pieces), true, out);
+
+    if (!out.empty())
+        return true;
+
+    //single square moves
+    uint32_t occupied = pos.black_men | pos.black_kings | pos.white_men | pos.white_kings;
+    for (uint32_t pieces = men | kings; pieces; pieces &= pieces - 1) {
+        int square = __builtin_ctz(pieces);
+        uint32_t from = 1u << square;
+        bool king = (kings & from) != 0;
+
+        for (int d = 0; d < 4; d++) {
+            if ((!king) && (black == (d < 2)))
+                continue;
+
+            int land = step[square][d];
+            if ((land < 0) || (occupied & (1u << land)))
+                continue;
+
+            TB_position next = pos;
+            uint32_t to = 1u << land;
+            if (black) {
+                if (king) {
+                    next.black_kings = (next.black_kings & ~from) | to;
+                } else if (to & BLACK_CROWN) {
+                    next.black_men &= ~from, next.black_kings |= to;
+                } else {
+                    next.black_men = (next.black_men & ~from) | to;
+                }
+            } else {
+                if (king) {
+                    next.white_kings = (next.white_kings & ~from) | to;
+                } else if (to & WHITE_CROWN) {
+                    next.white_men &= ~from, next.white_kings |= to;
+                } else {
+                    next.white_men = (next.white_men & ~from) | to;
+                }
+            }
+            out.push_back(next);
+        }
+    }
+
+    return false;
+}
+
+//file_name, builds the name of a slice's database file, e.g. dir/tb_1021.wdl
+//parameters: a ref to a directory string, a ref to the slice, a bool for the distance file
+//returns: the file name
+string Tablebase::file_name(const string &dir, const TB_slice &slice, bool dtc) {
+    char name[32];
+    snprintf(name, sizeof(name), "tb_%d%d%d%d.%s", slice.bm, slice.bk, slice.wm, slice.wk,
+    dtc ? "dtc" : "wdl");
+
+    return dir + "/" + name;
+}
+
+//compress_wdl, run-length encodes win/loss/draw values, with the value in the low two bits of each
+//byte and the run length less one in the high six
+//parameters: a pointer to the values, a count, a ref to the output vector to append to
+//returns: void
+void Tablebase::compress_wdl(const uint8_t *values, uint32_t count, vector<uint8_t> &out) {
+    uint32_t i = 0;
+
+    while (i < count) {
+        uint32_t run = 1;
+        while ((i + run < count) && (run < 64) && (values[i + run] == values[i]))
+            run++;
+
+        out.push_back((uint8_t) (((run - 1) << 2) | (values[i] & 3)));
+        i += run;
+    }
+}
+
+//expand_wdl, decodes a block written by compress_wdl. Runs past BLOCK values, which only a damaged file
+//has, are cut off rather than written past the end of the values.
+//parameters: a pointer to the encoded bytes, their length, a pointer to the BLOCK values to fill
+//returns: void
+void Tablebase::expand_wdl(const uint8_t *data, uint32_t length, uint8_t *values) {
+    uint32_t filled = 0;
+
+    for (uint32_t i = 0; (i < length) && (filled < BLOCK); i++) {
+        uint32_t run = (data[i] >> 2) + 1;
+        if (run > BLOCK - filled)
+            run = BLOCK - filled;
+        memset(values + filled, data[i] & 3, run);
+        filled += run;
+    }
+}
+
+//compress_dtc, run-length encodes distance values as pairs of run length and value
+//parameters: a pointer to the values, a count, a ref to the output vector to append to
+//returns: void
+void Tablebase::compress_dtc(const uint8_t *values, uint32_t count, vector<uint8_t> &out) {
+    uint32_t i = 0;
+
+    while (i < count) {
+        uint32_t run = 1;
+        while ((i + run < count) && (run < 255) && (values[i + run] == values[i]))
+            run++;
+
+        out.push_back((uint8_t) run);
+        out.push_back(values[i]);
+        i += run;
+    }
+}
+
+//expand_dtc, decodes a block written by compress_dtc, cutting off runs past BLOCK values as expand_wdl
+//does
+//parameters: a pointer to the encoded bytes, their length, a pointer to the BLOCK values to fill
+//returns: void
+void Tablebase::expand_dtc(const uint8_t *data, uint32_t length, uint8_t *values) {
+    uint32_t filled = 0;
+
+    for (uint32_t i = 0; (i + 1 < length) && (filled < BLOCK); i += 2) {
+        uint32_t run = data[i];
+        if (run > BLOCK - filled)
+            run = BLOCK - filled;
+        memset(values + filled, data[i + 1], run);
+        filled += run;
+    }
+}
+
+//write_file, compresses both sides to move of a slice block by block and writes them after the
+//header and the table of block offsets
+//parameters: a ref to the file name, a ref to the slice, a pointer to 2 * slice.size values with black
+//to move first, a bool for whether the values are distances rather than win/loss/draw
+//returns: a bool for whether the file was written
+bool Tablebase::write_file(const string &name, const TB_slice &slice, const uint8_t *values,
+bool dtc) {
+    TB_header header;
+    memset(&header, 0, sizeof(header));
+    header.magic = MAGIC, header.version = VERSION;
+    header.bm = slice.bm, header.bk = slice.bk, header.wm = slice.wm, header.wk = slice.wk;
+    header.block = BLOCK;
+    header.positions = 2 * slice.size;
+    header.blocks = (uint32_t) ((header.positions + BLOCK - 1) / BLOCK);
+    header.dtc = dtc;
+
+    vector<uint64_t> offsets;
+    vector<uint8_t> data;
+    for (uint32_t b = 0; b < header.blocks; b++) {
+        uint64_t first = (uint64_t) b * BLOCK;
+        uint32_t count = (uint32_t) ((header.positions - first < BLOCK) ?
+        (header.positions - first) : BLOCK);
+
+        offsets.push_back(data.size());
+        if (dtc) {
+            compress_dtc(values + first, count, data);
+        } else {
+            compress_wdl(values + first, count, data);
+        }
+    }
+    offsets.push_back(data.size());
+
+    FILE *file = fopen(name.c_str(), "wb");
+    if (file == NULL)
+        return false;
+
+    bool written = (fwrite(&header, sizeof(header), 1, file) == 1) &&
+    (fwrite(&offsets[0], sizeof(uint64_t), offsets.size(), file) == offsets.size()) &&
+    ((data.empty()) || (fwrite(&data[0], 1, data.size(), file) == data.size()));
+
+    return (fclose(file) == 0) && written;
+}
+
+//constructor, finds how many pieces the databases in a directory cover, without opening any. The
+//databases are only usable up to a number of pieces if every smaller one is present, so the count
+//stops at the first number of pieces with no kings-only database.
+//parameters: a ref to the directory, a size_t for the number of blocks to keep decoded
+//returns: NA
+Tablebase::Tablebase(const string &directory, size_t cache_blocks) {
+    struct stat info;
+
+    init();
+    dir = directory;
+    capacity = (cache_blocks > 2) ? cache_blocks : 2;
+
+    pieces = 0;
+    for (int n = 2; n <= MAX_PIECES; n++) {
+        if (stat(file_name(dir, make_slice(0, n / 2, 0, n - (n / 2)), false).c_str(), &info) != 0)
+            break;
+        pieces = n;
+    }
+}
+
+//destructor, unmaps every mapped file
+//parameters: NA
+//returns: NA
+Tablebase::~Tablebase() {
+    for (unordered_map<int, Mapped>::iterator i = files.begin(); i != files.end(); i++) {
+        if (i->second.base != NULL)
+            munmap((void*) i->second.base, i->second.length);
+    }
+}
+
+//convert, reads a Board's pieces into database format. The reversed board has its columns
+//mirrored, which is a symmetry of the game, so its pieces are mirrored back.
+//parameters: a ref to the Board
+//returns: the position
+TB_position Tablebase::convert(Board &ref) {
+    TB_position pos = {0, 0, 0, 0};
+    bool mirror = (ref.look(0, 0) != ' ');
+
+    for (int i = 0; i < ref.get_num_black(); i++) {
+        int col = mirror ? 7 - ref.get_place_col_b(i) : ref.get_place_col_b(i);
+        uint32_t bit = 1u << (((ref.get_place_row_b(i) * 8) + col) / 2);
+
+        if (ref.get_place_king_b(i)) {
+            pos.black_kings |= bit;
+        } else {
+            pos.black_men |= bit;
+        }
+    }
+
+    for (int i = 0; i < ref.get_num_white(); i++) {
+        int col = mirror ? 7 - ref.get_place_col_w(i) : ref.get_place_col_w(i);
+        uint32_t bit = 1u << (((ref.get_place_row_w(i) * 8) + col) / 2);
+
+        if (ref.get_place_king_w(i)) {
+            pos.white_kings |= bit;
+        } else {
+            pos.white_men |= bit;
+        }
+    }
+
+    return pos;
+}
+
+//map_file, maps a slice's database file read-only the first time it's asked for, and checks its
+//header. A file that's missing or doesn't match is remembered so it's only tried once.
+//parameters: a ref to the slice, a bool for the distance file, a size_t ref set to the file's length
+//returns: a pointer to the start of the file, or NULL
+const uint8_t* Tablebase::map_file(const TB_slice &slice, bool dtc, size_t &length) {
+    int key = (((slice.bm * 1000) + (slice.bk * 100) + (slice.wm * 10) + slice.wk) * 2) + dtc;
+    unordered_map<int, Mapped>::iterator found = files.find(key);
+    if (found != files.end()) {
+        length = found->second.length;
+        return found->second.base;
+    }
+
+    Mapped &entry = files[key];
+    entry.base = NULL, entry.length = 0;
+    length = 0;
+
+    int fd = open(file_name(dir, slice, dtc).c_str(), O_RDONLY);
+    if (fd < 0)
+        return NULL;
+
+    struct stat info;
+    if ((fstat(fd, &info) != 0) || ((size_t) info.st_size < sizeof(TB_header))) {
+        close(fd);
+        return NULL;
+    }
+
+    void *base = mmap(NULL, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd); //the mapping keeps the file open
+    if (base == MAP_FAILED)
+        return NULL;
+
+    const TB_header *header = (const TB_header*) base;
+    if ((header->magic != MAGIC) || (header->version != VERSION) || (header->bm != slice.bm) ||
+    (header->bk != slice.bk) || (header->wm != slice.wm) || (header->wk != slice.wk) ||
+    (header->block != BLOCK) || (header->positions != 2 * slice.size) ||
+    ((bool) header->dtc != dtc) || (sizeof(TB_header) + ((header->blocks + 1) * sizeof(uint64_t)) >
+    (size_t) info.st_size)) {
+        munmap(base, info.st_size);
+        return NULL;
+    }
+
+    entry.base = (const uint8_t*) base, entry.length = info.st_size;
+    length = entry.length;
+    return entry.base;
+}
+
+//block, finds the decoded block holding an index, decoding it into the least recently used cache
+//entry if it isn't cached. A block whose offsets go backwards or past the end of the file isn't read.
+//parameters: a ref to the slice, a bool for the distance file, the index counting white to move
+//positions after all black to move ones
+//returns: a pointer to the block's values, or NULL
+const uint8_t* Tablebase::block(const TB_slice &slice, bool dtc, uint64_t idx) {
+    uint64_t number = idx / BLOCK;
+    uint64_t key = ((uint64_t) ((slice.bm << 9) | (slice.bk << 6) | (slice.wm << 3) | slice.wk) << 33) |
+    ((uint64_t) dtc << 32) | number;
+
+    unordered_map<uint64_t, list<Cached>::iterator>::iterator found = cached.find(key);
+    if (found != cached.end()) {
+        lru.splice(lru.begin(), lru, found->second); //move to the front
+        return lru.front().values;
+    }
+
+    size_t file_length;
+    const uint8_t *base = map_file(slice, dtc, file_length);
+    if (base == NULL)
+        return NULL;
+
+    const TB_header *header = (const TB_header*) base;
+    const uint64_t *offsets = (const uint64_t*) (base + sizeof(TB_header));
+    const uint8_t *data = (const uint8_t*) (offsets + header->blocks + 1);
+
+    //map_file checked the offsets fit, so this is how many bytes of blocks follow them
+    uint64_t data_length = file_length - (data - base);
+    if ((number >= header->blocks) || (offsets[number] > offsets[number + 1]) ||
+    (offsets[number + 1] > data_length))
+        return NULL;
+
+    //reuse the least recently used entry once the cache is full
+    if (lru.size() >= capacity) {
+        cached.erase(lru.back().key);
+        lru.splice(lru.begin(), lru, --lru.end());
+    } else {
+        lru.push_front(Cached());
+    }
+
+    lru.front().key = key;
+    cached[key] = lru.begin();
+
+    uint32_t length = (uint32_t) (offsets[number + 1] - offsets[number]);
+    if (dtc) {
+        expand_dtc(data + offsets[number], length, lru.front().values);
+    } else {
+        expand_wdl(data + offsets[number], length, lru.front().values);
+    }
+
+    return lru.front().values;
+}
+
+//probe, looks up a position's value, and its distance to conversion when it isn't a draw and the
+//distance file is present
+//parameters: a ref to the position, a bool for whether black is to move, an int ref for the distance,
+//set to 0 if unknown
+//returns: the value, UNKNOWN if no database covers the position
+uint8_t Tablebase::probe(const TB_position &pos, bool black, int &dist) {
+    dist = 0;
+
+    if ((!(pos.black_men | pos.black_kings)) || (!(pos.white_men | pos.white_kings)))
+        return UNKNOWN;
+
+    TB_slice slice = slice_of(pos);
+    if (slice.bm + slice.bk + slice.wm + slice.wk > pieces)
+        return UNKNOWN;
+
+    uint64_t idx = index(slice, pos) + (black ? 0 : slice.size);
+    const uint8_t *values = block(slice, false, idx);
+    if (values == NULL)
+        return UNKNOWN;
+
+    uint8_t value = values[idx % BLOCK];
+    if (value != DRAW) {
+        const uint8_t *dists = block(slice, true, idx);
+        if (dists != NULL)
+            dist = dists[idx % BLOCK];
+    }
+
+    return value;
+}
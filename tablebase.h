@@ -0,0 +1,195 @@
+/*tablebase.h, the header file for the endgame databases. Holds the compact position format used by
+the databases, the perfect hash that maps every position of a material signature ("slice") to a
+unique index, a self-contained move generator for that format, and the block-compressed file
+format the databases are written in.
+
+Squares are numbered 0 to 31 the same way as the Board hashing key, (row * 8 + column) / 2,
+in the standard orientation with black on rows 0 to 2. Values are stored from the point of view of
+the side to move.
+
+A Tablebase object probes the databases from inside a search. Files are memory-mapped read-only the
+first time a material signature is probed, so opening is cheap however large the databases are and
+several engine processes share one copy in the page cache. Decompressed blocks are kept in a small
+least-recently-used cache.*/
+
+#include <string>
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <stdint.h>
+#include "board.h"
+
+using namespace std;
+
+#ifndef TABLEBASE_H
+#define TABLEBASE_H
+
+//position in database format, one bit per square for each piece type
+struct TB_position {
+    uint32_t black_men, black_kings;
+    uint32_t white_men, white_kings;
+};
+
+//material signature of a database, with the number of positions for one side to move
+struct TB_slice {
+    int bm, bk, wm, wk;
+    uint64_t size;
+};
+
+//fixed-size header at the start of every database file, followed by blocks + 1 byte offsets 
+//(uint64_t, relative to the end of the offset table) and then the compressed blocks
+struct TB_header {
+    uint32_t magic, version;
+    uint8_t bm, bk, wm, wk;
+    uint32_t block;
+    uint64_t positions;
+    uint32_t blocks;
+    uint32_t dtc;
+};
+
+class Tablebase {
+    public:
+        /***Constants***/
+
+        //largest number of pieces the format and generator support
+        const static int MAX_PIECES = 6;
+
+        //position values, from the point of view of the side to move
+        const static uint8_t UNKNOWN = 0, WIN = 1, LOSS = 2, DRAW = 3;
+
+        //number of positions per compressed block
+        const static uint32_t BLOCK = 4096;
+
+        //file identification
+        const static uint32_t MAGIC = 0x42445454, VERSION = 1;
+
+        /***Indexing***/
+
+        //fill the binomial coefficient and square tables, safe to call more than once
+        static void init();
+
+        //make a slice descriptor for a material signature, with its size filled in
+        static TB_slice make_slice(int bm, int bk, int wm, int wk);
+
+        //get the slice a position belongs to
+        static TB_slice slice_of(const TB_position &pos);
+
+        //perfect hash of a position within its slice
+        static uint64_t index(const TB_slice &slice, const TB_position &pos);
+
+        //inverse of index, rebuilds the position at an index of a slice
+        static TB_position position(const TB_slice &slice, uint64_t idx);
+
+        /***Move generation***/
+
+        //fill a vector with the positions reachable in one turn, returns whether the moves are jumps
+        static bool successors(const TB_position &pos, bool black, vector<TB_position> &out);
+
+        //get the row of a square
+        static int row_of(int square) {
+            return square >> 2;
+        }
+
+        //get the column of a square
+        static int col_of(int square) {
+            return ((square & 3) << 1) + (((square >> 2) & 1) ? 0 : 1);
+        }
+
+        /***Files***/
+
+        //name of the database file for a slice
+        static string file_name(const string &dir, const TB_slice &slice, bool dtc);
+
+        //run-length encode one block of win/loss/draw values, one byte per run of up to 64
+        static void compress_wdl(const uint8_t *values, uint32_t count, vector<uint8_t> &out);
+
+        //decode a block written by compress_wdl, stopping at BLOCK values
+        static void expand_wdl(const uint8_t *data, uint32_t length, uint8_t *values);
+
+        //run-length encode one block of distances, a count and a value byte per run
+        static void compress_dtc(const uint8_t *values, uint32_t count, vector<uint8_t> &out);
+
+        //decode a block written by compress_dtc, stopping at BLOCK values
+        static void expand_dtc(const uint8_t *data, uint32_t length, uint8_t *values);
+
+        //write both sides to move of a slice to a block-compressed file, returns false on failure
+        static bool write_file(const string &name, const TB_slice &slice, const uint8_t *values,
+        bool dtc);
+
+        /***Probing***/
+
+        //constructor, looks for databases in a directory and keeps up to cache_blocks blocks decoded
+        Tablebase(const string &directory, size_t cache_blocks);
+
+        //destructor, unmaps the files
+        ~Tablebase();
+
+        //largest number of pieces every database is present for, 0 if there are none
+        int get_pieces() {
+            return pieces;
+        }
+
+        //look up a position, returns UNKNOWN if it isn't covered, and fills in its distance to
+        //conversion if a distance file is present
+        uint8_t probe(const TB_position &pos, bool black, int &dist);
+
+        //convert a Board in either orientation to database format
+        static TB_position convert(Board &ref);
+
+    private:
+        //a database file, mapped the first time it's needed
+        struct Mapped {
+            const uint8_t *base;
+            size_t length;
+        };
+
+        //a decoded block in the cache
+        struct Cached {
+            uint64_t key;
+            uint8_t values[BLOCK];
+        };
+
+        //directory holding the database files
+        string dir;
+
+        //number of pieces covered
+        int pieces;
+
+        //files by slice, with NULL bases for files that are missing or invalid
+        unordered_map<int, Mapped> files;
+
+        //decoded blocks, most recently used first, and their positions in the list by key
+        list<Cached> lru;
+        unordered_map<uint64_t, list<Cached>::iterator> cached;
+        size_t capacity;
+
+        //map a slice's file, setting its length in bytes, returns NULL if it can't be used
+        const uint8_t* map_file(const TB_slice &slice, bool dtc, size_t &length);
+
+        //get the decoded block holding an index, returns NULL if the file can't be used
+        const uint8_t* block(const TB_slice &slice, bool dtc, uint64_t idx);
+
+
+        //binomial coefficients, choose[n][k]
+        static uint64_t choose[33][MAX_PIECES + 1];
+
+        //neighbouring squares in each direction, -1 off the board
+        //directions: 0 up-left, 1 up-right, 2 down-left, 3 down-right (down is black's forward)
+        static int step[32][4];
+
+        //rank a set of squares within a domain of allowed squares
+        static uint64_t rank(uint32_t set, uint32_t domain);
+
+        //inverse of rank, picks num squares out of a domain
+        static uint32_t unrank(uint64_t r, int num, uint32_t domain);
+
+        //number of men arrangements before the group with k black men on black's back row
+        static uint64_t men_offset(int bm, int wm, int k);
+
+        //recursive helper to successors, continues a jump sequence from a square, returns whether
+        //any jump could be made from it
+        static bool jump_from(const TB_position &pos, bool black, int square, bool king,
+        vector<TB_position> &out);
+};
+
+#endif
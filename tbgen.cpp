@@ -0,0 +1,285 @@
+/*tbgen.cpp, the main for the endgame database generator. Builds win/loss/draw databases, and
+optionally distance-to-conversion databases, for every position with up to the requested number
+of pieces, writing one block-compressed file per material signature for the engines to ship with.
+
+Databases are solved by retrograde analysis, smallest first. Within a material signature, every
+move either stays in the signature or leads to one that is already solved (a jump removes a piece,
+a crowning turns a man into a king), so signatures with the same number of pieces are solved in
+order of their number of men. Each signature is then iterated to a fixed point: a position is a
+win once any move leads to a loss for the opponent, and a loss once every move leads to a win for
+the opponent. Positions left undecided when nothing changes are draws. Each round reads only the
+values from the previous round, so the round a position is decided in is its distance to
+conversion, and the rounds are split across threads by index range.
+
+Usage: ./tbgen [-p pieces] [-t threads] [-d] [-o directory]*/
+
+#include <iostream>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <thread>
+#include <chrono>
+#include <sys/stat.h>
+#include "tablebase.h"
+
+using namespace std;
+
+//a solved slice, kept in memory with two bits per position so larger slices can look it up
+struct Solved {
+    TB_slice slice;
+    vector<uint8_t> packed;
+};
+
+//a slice being solved, with a value and a distance for every position, black to move first
+struct Work {
+    TB_slice slice;
+    vector<uint8_t> value, next_value;
+    vector<uint8_t> dist, next_dist;
+};
+
+//solved slices, keyed by material signature
+map<int, Solved> solved;
+
+//get a key for a material signature
+int slice_key(const TB_slice &slice);
+
+//look up a value for the side to move in a solved slice, or a position with no pieces left
+uint8_t lookup(const TB_position &pos, bool black);
+
+//decide the positions in one part of a slice for one round, returns the number decided
+uint64_t solve_range(Work *work, uint64_t first, uint64_t last);
+
+//solve every position of a slice, then write and store it
+void solve_slice(const TB_slice &slice, int threads, bool dtc, const string &dir);
+
+//order slices with fewer men first
+bool fewer_men(const TB_slice &a, const TB_slice &b);
+
+int main(int argc, char *argv[]) {
+    int pieces = Tablebase::MAX_PIECES;
+    int threads = thread::hardware_concurrency();
+    bool dtc = false;
+    string dir = "db";
+
+    for (int i = 1; i < argc; i++) {
+        if ((!strcmp(argv[i], "-p")) && (i + 1 < argc)) {
+            pieces = atoi(argv[++i]);
+        } else if ((!strcmp(argv[i], "-t")) && (i + 1 < argc)) {
+            threads = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "-d")) {
+            dtc = true;
+        } else if ((!strcmp(argv[i], "-o")) && (i + 1 < argc)) {
+            dir = argv[++i];
+        } else {
+            cout << "Usage: " << argv[0] << " [-p pieces] [-t threads] [-d] [-o directory]\n";
+            return 1;
+        }
+    }
+
+    if ((pieces < 2) || (pieces > Tablebase::MAX_PIECES)) {
+        cout << "Number of pieces must be between 2 and " << Tablebase::MAX_PIECES << endl;
+        return 1;
+    }
+    if (threads < 1)
+        threads = 1;
+
+    mkdir(dir.c_str(), 0755);
+    Tablebase::init();
+
+    for (int n = 2; n <= pieces; n++) {
+        //every material signature with n pieces and at least one piece of each color
+        vector<TB_slice> slices;
+        for (int black = 1; black < n; black++) {
+            int white = n - black;
+            for (int bm = 0; bm <= black; bm++) {
+                for (int wm = 0; wm <= white; wm++) {
+                    slices.push_back(Tablebase::make_slice(bm, black - bm, wm, white - wm));
+                }
+            }
+        }
+
+        //crowning leads to a slice with one man fewer, so those are solved first
+        stable_sort(slices.begin(), slices.end(), fewer_men);
+
+        for (size_t i = 0; i < slices.size(); i++)
+            solve_slice(slices[i], threads, dtc, dir);
+    }
+
+    return 0;
+}
+
+//slice_key, packs a material signature into an int
+//parameters: a ref to the slice
+//returns: an int key
+int slice_key(const TB_slice &slice) {
+    return (slice.bm * 1000) + (slice.bk * 100) + (slice.wm * 10) + slice.wk;
+}
+
+//fewer_men, comparison for sorting slices so that those with fewer men come first
+//parameters: refs to two slices
+//returns: a bool for whether the first has fewer men
+bool fewer_men(const TB_slice &a, const TB_slice &b) {
+    return (a.bm + a.wm) < (b.bm + b.wm);
+}
+
+//lookup, finds the value of a position in a solved slice, from the side to move's point of view. A
+//side with no pieces left has lost.
+//parameters: a ref to the position, a bool for whether black is to move
+//returns: the value
+uint8_t lookup(const TB_position &pos, bool black) {
+    if ((black) && (!(pos.black_men | pos.black_kings)))
+        return Tablebase::LOSS;
+    if ((!black) && (!(pos.white_men | pos.white_kings)))
+        return Tablebase::LOSS;
+
+    TB_slice slice = Tablebase::slice_of(pos);
+    const Solved &entry = solved.find(slice_key(slice))->second;
+    uint64_t idx = Tablebase::index(slice, pos) + (black ? 0 : slice.size);
+
+    return (entry.packed[idx >> 2] >> ((idx & 3) << 1)) & 3;
+}
+
+//solve_range, makes one round over part of a slice, deciding positions from the values of their
+//successors at the end of the last round
+//parameters: a pointer to the slice's work, the first index and one past the last, both counting
+//white to move positions after all black to move ones
+//returns: the number of positions decided
+uint64_t solve_range(Work *work, uint64_t first, uint64_t last) {
+    const TB_slice &slice = work->slice;
+    vector<TB_position> moves;
+    uint64_t decided = 0;
+
+    for (uint64_t i = first; i < last; i++) {
+        work->next_value[i] = work->value[i];
+        work->next_dist[i] = work->dist[i];
+        if (work->value[i] != Tablebase::UNKNOWN)
+            continue;
+
+        bool black = (i < slice.size);
+        TB_position pos = Tablebase::position(slice, black ? i : i - slice.size);
+        Tablebase::successors(pos, black, moves);
+
+        //a side that can't move has lost
+        uint8_t result = Tablebase::LOSS, dist = 0;
+        int best_win = 256, worst_loss = -1;
+        for (size_t m = 0; m < moves.size(); m++) {
+            TB_slice next = Tablebase::slice_of(moves[m]);
+            uint8_t value;
+            int distance = 0;
+
+            if ((next.bm == slice.bm) && (next.bk == slice.bk) && (next.wm == slice.wm) &&
+            (next.wk == slice.wk)) {
+                uint64_t idx = Tablebase::index(slice, moves[m]) + (black ? slice.size : 0);
+                value = work->value[idx];
+                distance = work->dist[idx];
+            } else {
+                value = lookup(moves[m], !black); //conversion into a smaller or other slice
+            }
+
+            if (value == Tablebase::LOSS) {
+                if (distance < best_win)
+                    best_win = distance;
+            } else if (value == Tablebase::WIN) {
+                if (distance > worst_loss)
+                    worst_loss = distance;
+            } else {
+                result = Tablebase::UNKNOWN; //some move neither wins nor loses yet
+            }
+        }
+
+        if (best_win < 256) {
+            result = Tablebase::WIN;
+            dist = (best_win + 1 < 255) ? best_win + 1 : 255;
+        } else if (result == Tablebase::LOSS) {
+            dist = (worst_loss + 1 < 255) ? worst_loss + 1 : 255;
+        }
+
+        if (result != Tablebase::UNKNOWN) {
+            work->next_value[i] = result;
+            work->next_dist[i] = dist;
+            decided++;
+        }
+    }
+
+    return decided;
+}
+
+//solve_slice, iterates a slice to a fixed point across several threads, marks undecided positions
+//as draws, writes the database files and keeps a packed copy for later slices
+//parameters: a ref to the slice, an int for the number of threads, a bool for whether to write the
+//distance file, a ref to the output directory
+//returns: void
+void solve_slice(const TB_slice &slice, int threads, bool dtc, const string &dir) {
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    uint64_t total = 2 * slice.size;
+
+    Work work;
+    work.slice = slice;
+    work.value.assign(total, Tablebase::UNKNOWN);
+    work.next_value.assign(total, Tablebase::UNKNOWN);
+    work.dist.assign(total, 0);
+    work.next_dist.assign(total, 0);
+
+    int rounds = 0;
+    uint64_t decided;
+    do {
+        vector<thread> pool;
+        vector<uint64_t> counts(threads, 0);
+        uint64_t part = (total + threads - 1) / threads;
+
+        for (int t = 0; t < threads; t++) {
+            uint64_t first = t * part;
+            uint64_t last = ((t + 1) * part < total) ? (t + 1) * part : total;
+            if (first >= last)
+                continue;
+            pool.push_back(thread([&work, &counts, t, first, last]() {
+                counts[t] = solve_range(&work, first, last);
+            }));
+        }
+        for (size_t t = 0; t < pool.size(); t++)
+            pool[t].join();
+
+        decided = 0;
+        for (int t = 0; t < threads; t++)
+            decided += counts[t];
+
+        work.value.swap(work.next_value);
+        work.dist.swap(work.next_dist);
+        rounds++;
+    } while (decided > 0);
+
+    //count results, and call everything still undecided a draw
+    uint64_t wins = 0, losses = 0, draws = 0;
+    for (uint64_t i = 0; i < total; i++) {
+        if (work.value[i] == Tablebase::UNKNOWN)
+            work.value[i] = Tablebase::DRAW;
+
+        if (work.value[i] == Tablebase::WIN) {
+            wins++;
+        } else if (work.value[i] == Tablebase::LOSS) {
+            losses++;
+        } else {
+            draws++;
+        }
+    }
+
+    string name = Tablebase::file_name(dir, slice, false);
+    if (!Tablebase::write_file(name, slice, &work.value[0], false))
+        cout << "Could not write " << name << endl;
+    if ((dtc) && (!Tablebase::write_file(Tablebase::file_name(dir, slice, true), slice,
+    &work.dist[0], true)))
+        cout << "Could not write " << Tablebase::file_name(dir, slice, true) << endl;
+
+    Solved &entry = solved[slice_key(slice)];
+    entry.slice = slice;
+    entry.packed.assign((total + 3) / 4, 0);
+    for (uint64_t i = 0; i < total; i++)
+        entry.packed[i >> 2] |= work.value[i] << ((i & 3) << 1);
+
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << name << ": " << total << " positions, " << wins << " wins, " << losses << " losses, "
+    << draws << " draws, " << rounds << " rounds, " << seconds << "s\n";
+}